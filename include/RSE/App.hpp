@@ -5,11 +5,25 @@
 #include <cinolib/drawable_segment_soup.h>
 #include <cinolib/meshes/drawable_hexmesh.h>
 #include <RSE/AxesGuiItem.hpp>
+#include <RSE/UpdateGuiItem.hpp>
 #include <RSE/Grid.hpp>
+#include <RSE/GridOverlay.hpp>
+#include <RSE/HexDrawable.hpp>
+#include <RSE/HexDrawableBatch.hpp>
 #include <RSE/AppSidebarItem.hpp>
+#include <RSE/PreviewSidebarItem.hpp>
+#include <RSE/LibrarySidebarItem.hpp>
+#include <RSE/ConsoleSidebarItem.hpp>
+#include <RSE/MemorySidebarItem.hpp>
+#include <RSE/MemoryReport.hpp>
+#include <RSE/InputLog.hpp>
 #include <cstddef>
 #include <vector>
 #include <string>
+#include <optional>
+#include <ostream>
+#include <cstdint>
+#include <chrono>
 
 namespace RSE
 {
@@ -73,19 +87,49 @@ namespace RSE
 		static void printBindings();
 
 		static const HexVerts cubeVerts;
+		static const HexVertData<std::string> c_vertLabels;
 		cinolib::GLcanvas m_canvas;
-		cinolib::DrawableSegmentSoup m_gridMesh;
+		GridOverlay m_gridOverlay;
 		cinolib::DrawableSegmentSoup m_borderMesh;
 		AxesGuiItem m_axesWidget;
+		UpdateGuiItem m_updateWidget;
 		AppSidebarItem m_appWidget;
-		std::vector<cinolib::DrawableHexmesh<>*> m_childMeshes;
+		PreviewSidebarItem m_previewWidget;
+		LibrarySidebarItem m_libraryWidget;
+		ConsoleSidebarItem m_consoleWidget;
+		MemorySidebarItem m_memoryWidget;
+		cinolib::DrawableHexmesh<>* m_previewMesh{};
+		std::vector<HexDrawable*> m_childMeshes;
+		// draws m_childMeshes, which are not pushed to the canvas
+		HexDrawableBatch m_childBatch{ m_childMeshes };
 		Grid m_grid;
 		std::vector<unsigned int> vertsOrder;
 		std::size_t m_mouseGridIndex{};
+		// enabled vertex markers of each child, one bit per vertex; they are built on demand
+		std::vector<std::uint8_t> m_childMarkers;
+		std::vector<std::uint8_t> m_childCulledFaces;
+		std::vector<bool> m_childDirty;
+		bool m_vertMarkersDirty{};
+		InputLog* m_inputLog{};
+		std::chrono::steady_clock::time_point m_inputLogStart{};
+		std::size_t m_modelEventCount{};
+		std::vector<InputLog::EModelEvent>* m_replayedModelEvents{};
+		// view work deferred by the current batch
+		bool m_batchRebuild{};
+		bool m_batchCursor{};
+		bool m_batchActiveVert{};
+		std::vector<std::size_t> m_batchChildren{};
 
 		void onGridUpdate();
 		void onGridCursorUpdate();
+		bool drawable(std::size_t _child) const;
+		// faces shared with another drawable child in solid mode, one bit per face
+		std::uint8_t culledFaces(std::size_t _child) const;
+		void updateChildMesh(std::size_t _child);
 		void onChildUpdate(std::size_t _child);
+		void onChildrenUpdate(const std::vector<std::size_t>& _children);
+		void onChildAdjacencyUpdate(std::size_t _child);
+		void addChildMesh();
 		void onChildAdd();
 		void onChildrenClear();
 		void onChildRemove(std::size_t _child);
@@ -95,18 +139,49 @@ namespace RSE
 		void onSetActiveVert(std::size_t _vert);
 		void onAdvanceActiveVert(bool _advance);
 		void onMouseMove();
+		void onMouseRay(const RVec3& _origin, const RVec3& _dir);
 		bool onKeyPress(int _key, int _modifiers);
 		bool onClick(int _modifiers);
 		void setWindowTitle();
+		void onUpdate();
+		void onPreviewUpdate();
+		bool deferred(bool& _flag);
+		bool deferredChild(std::size_t _child);
+		void onBatchEnd();
+		void updateVertMarkers();
+		void onModelEvent(InputLog::EModelEvent _event);
+		void recordInput(const InputLog::Event& _event);
+		void loadSync(const std::string& _file);
+		void memoryReport(MemoryReport& _report) const;
 
 	public:
 
+		struct RenderStats final
+		{
+			std::vector<Real> frameSeconds;
+			std::vector<std::uint64_t> frameHashes;
+		};
+
 		App();
 
 		void open(const std::string& _file);
 
 		int launch();
 
+		// loads _log.file if set, then launches the app, appending every input, console command and model event to _log
+		int record(InputLog& _log);
+
+		// replays _log at maximum speed in a hidden window, timing each handler
+		// and, if _render is set, each frame drawn into an offscreen framebuffer;
+		// throws std::runtime_error if the model events diverge from the recorded ones
+		LatencyReport replay(const InputLog& _log, bool _render);
+
+		// renders _frames frames of an orbit around the scheme into an offscreen framebuffer of a hidden window,
+		// optionally saving each frame as a PPM image named _imagePrefix<frame>.ppm
+		RenderStats render(const std::string& _file, std::size_t _frames, const std::optional<std::string>& _imagePrefix);
+
 	};
 
+	std::ostream& operator<<(std::ostream& _stream, const App::RenderStats& _stats);
+
 }
\ No newline at end of file
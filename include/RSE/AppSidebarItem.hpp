@@ -6,9 +6,21 @@
 #include <RSE/ChildControl.hpp>
 #include <RSE/HexControl.hpp>
 #include <RSE/SourceControl.hpp>
+#include <RSE/Autosaver.hpp>
+#include <RSE/schemeIO.hpp>
+#include <RSE/SchemeValidator.hpp>
+#include <RSE/FaceIndex.hpp>
+#include <RSE/CppExporter.hpp>
+#include <RSE/Grid.hpp>
+#include <RSE/symmetry.hpp>
+#include <RSE/generators.hpp>
+#include <RSE/MemoryReport.hpp>
 #include <vector>
+#include <memory>
 #include <string>
 #include <optional>
+#include <chrono>
+#include <future>
 #include <cpputils/collections/Event.hpp>
 #include <cpputils/collections/DereferenceIterable.hpp>
 
@@ -26,6 +38,8 @@ namespace RSE
 
 		static constexpr Int c_maxSize{ 10 };
 		static constexpr Real c_maxSourceExtent{ 5 };
+		static constexpr std::chrono::seconds c_autosaveInterval{ 30 };
+		static constexpr std::chrono::milliseconds c_loadBudget{ 8 };
 
 		std::vector<ChildControl*> m_children;
 		SourceControl m_sourceControl;
@@ -34,12 +48,48 @@ namespace RSE
 		bool m_singleMode;
 		bool m_solidMode{ false };
 		std::optional<std::string> m_file{};
+		FaceIndex m_faceIndex;
+		CppExporter m_exporter{};
+		Autosaver m_autosaver;
+		// the children vertices packed in order, shared with the snapshots and copied on write
+		std::shared_ptr<std::vector<HexVertsU>> m_verts{ std::make_shared<std::vector<HexVertsU>>() };
+		bool m_autosaveDirty{ false };
+		std::chrono::steady_clock::time_point m_lastAutosave;
+		// unique per session, so that concurrent editors do not overwrite each other's recovery file
+		const std::string m_unnamedAutosaveFile;
+		std::future<schemeIO::Scheme> m_loadFuture{};
+		std::optional<schemeIO::Scheme> m_loadScheme{};
+		std::size_t m_loadedChildren{};
+		std::optional<SchemeValidator::Report> m_validation{};
+		Grid::EPrecision m_precision{ Grid::EPrecision::Single };
+		mutable std::optional<Real> m_precisionDeviation{};
+		std::size_t m_symmetry{ 1 };
+		generators::Params m_generator{};
+		std::size_t m_batchDepth{};
+		std::size_t m_revision{};
+
+		struct ExportCache final
+		{
+			std::size_t revision;
+			CppExporter exporter;
+			std::string code;
+			std::size_t duplicates;
+		};
+
+		mutable std::optional<ExportCache> m_exportCache{};
+
+		const ExportCache& exportResult() const;
+		void reportExport(const std::string& _target) const;
 
 		Int minRequiredSize() const;
 		void updateSelection();
+		void invalidate();
+		std::vector<HexVertsU>& mutableVerts();
+		void updateLoad();
 
-		void addChild(const IVec3& _min, const IVec3& _max);
-		void addChild(const HexVertsU& _verts);
+		std::vector<std::size_t> shownIndices() const;
+		std::vector<HexVertsU> childrenVerts(const std::vector<std::size_t>& _children) const;
+		void setChildrenVerts(const std::vector<std::size_t>& _children, const std::vector<HexVertsU>& _verts);
 
 	public:
 
@@ -53,8 +103,22 @@ namespace RSE
 		cpputils::collections::Event<AppSidebarItem> onChildAdd;
 		cpputils::collections::Event<AppSidebarItem> onFileChange;
 		cpputils::collections::Event<AppSidebarItem> onActiveVertChange;
+		cpputils::collections::Event<AppSidebarItem> onPrecisionChange;
 		cpputils::collections::Event<AppSidebarItem, std::size_t> onChildRemove;
 		cpputils::collections::Event<AppSidebarItem, std::size_t> onChildUpdate;
+		// view-only state of the child changed (shown, active, color or culling), with its vertices unchanged;
+		// unlike onChildUpdate it does not bump the revision
+		cpputils::collections::Event<AppSidebarItem, std::size_t> onChildViewUpdate;
+		cpputils::collections::Event<AppSidebarItem, std::size_t> onChildAdjacencyUpdate;
+		cpputils::collections::Event<AppSidebarItem, const std::vector<std::size_t>&> onChildrenUpdate;
+		cpputils::collections::Event<AppSidebarItem> onBatchEnd;
+
+		// events keep firing inside a batch, but listeners may defer their work until onBatchEnd
+		void beginBatch();
+
+		void endBatch();
+
+		bool batching() const;
 
 		void setHideCursor(bool _hidden);
 
@@ -62,20 +126,58 @@ namespace RSE
 
 		bool solidMode() const;
 
+		void setSize(Int _size);
+
+		void setPrecision(Grid::EPrecision _precision);
+
+		Grid::EPrecision precision() const;
+
+		Real precisionDeviation() const;
+
 		const std::optional<std::string>& file() const;
 
 		void clear();
 
 		void save(bool _new);
 
+		void saveAs(const std::string& _filename);
+
+		// bumped by every change to the source or the children
+		std::size_t revision() const;
+
+		void memoryReport(MemoryReport& _report) const;
+
+		// O(1), shares the packed vertices
+		Autosaver::Children snapshot() const;
+
+		std::string autosaveFile() const;
+
+		void update();
+
 		void addChildrenCursorGrid();
 
 		void flipShown();
 
 		void rotateShown();
 
+		// _copy keeps the shown children and adds their images; images identical to another child are dropped
+		void applySymmetryShown(const symmetry::Symmetry& _symmetry, bool _copy);
+
+		// adds the images of the shown children under the whole symmetry group
+		void symmetrizeShown();
+
 		void addChild();
 
+		void addChild(const IVec3& _min, const IVec3& _max);
+
+		void addChild(const HexVertsU& _verts);
+
+		// adds all the children in a single batch
+		void addChildren(const std::vector<HexVertsU>& _verts);
+
+		// fills the cursor with a generated family
+		void generateInCursor(const generators::Params& _params);
+
 		void cloneShown();
 
 		void removeShown();
@@ -94,13 +196,26 @@ namespace RSE
 
 		void removeChild(std::size_t _child);
 
+		// removes the children at the ascending indices _children in one pass, rebuilding the face index once
+		void removeChildren(const std::vector<std::size_t>& _children);
+
 		void load(const std::string& _filename);
 
 		void load();
 
+		bool loading() const;
+
+		const SchemeValidator::Report& validate();
+
+		// removes the children that are equal to an earlier one up to corner ordering
+		std::size_t mergeDuplicates();
+
+		// leaves out duplicate children without removing them; cached until the revision or the exporter settings change
 		std::string exportCode() const;
 
 		void exportCodeToFile() const;
+
+		void exportCodeToFile(const std::string& _filename) const;
 		
 		void exportCodeToClipboard() const;
 
@@ -128,6 +243,8 @@ namespace RSE
 
 		const SourceControl& source() const;
 
+		const FaceIndex& faceIndex() const;
+
 		bool shown(const ChildControl& _child) const;
 
 		ChildControls children() const;
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <RSE/types.hpp>
+#include <vector>
+#include <string>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace RSE
+{
+
+	class Autosaver final
+	{
+
+	public:
+
+		using Children = std::shared_ptr<const std::vector<HexVertsU>>;
+
+	private:
+
+		struct Job final
+		{
+			std::string filename;
+			Int size;
+			Children children;
+		};
+
+		mutable std::mutex m_mutex;
+		std::condition_variable m_condition;
+		std::condition_variable m_idle;
+		std::optional<Job> m_pending;
+		bool m_busy;
+		bool m_stop;
+		std::thread m_thread;
+
+		void run();
+
+	public:
+
+		Autosaver();
+
+		Autosaver(const Autosaver&) = delete;
+
+		Autosaver& operator=(const Autosaver&) = delete;
+
+		~Autosaver();
+
+		void request(const std::string& _filename, Int _size, Children _children);
+
+		bool busy() const;
+
+		// drops a pending request for _filename, waits for the running one and deletes the file if it exists
+		void discard(const std::string& _filename);
+
+	};
+
+}
\ No newline at end of file
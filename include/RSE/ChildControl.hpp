@@ -17,16 +17,13 @@ namespace RSE
 		bool m_selected;
 		bool m_active;
 		IHexControl m_hexControl;
-		Int m_maxSize;
 		Style m_style;
 
-		void update();
-
 	public:
 
 		enum class EResult
 		{
-			Updated, Removed, None 
+			Updated, ColorUpdated, Removed, None 
 		};
 
 		enum class EVisibilityMode
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <RSE/AppSidebarItem.hpp>
+#include <string>
+#include <string_view>
+#include <istream>
+#include <ostream>
+#include <cstddef>
+
+namespace RSE
+{
+
+	// textual interface to the editing operations of AppSidebarItem
+	class Commands final
+	{
+
+	private:
+
+		AppSidebarItem& m_app;
+
+	public:
+
+		Commands(AppSidebarItem& _app);
+
+		// runs a single command line, throwing std::runtime_error on bad input
+		void run(std::string_view _line, std::ostream& _output);
+
+		// runs every line of _script in a single batch, stopping at the first error;
+		// returns the number of commands run
+		std::size_t runScript(std::istream& _script, std::ostream& _output);
+
+		std::size_t runFile(const std::string& _filename, std::ostream& _output);
+
+		static void printHelp(std::ostream& _output);
+
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cinolib/gl/side_bar_item.h>
+#include <RSE/AppSidebarItem.hpp>
+#include <RSE/Commands.hpp>
+#include <cpputils/collections/Event.hpp>
+#include <string>
+#include <vector>
+#include <array>
+
+namespace RSE
+{
+
+	class ConsoleSidebarItem final : public cinolib::SideBarItem
+	{
+
+	private:
+
+		static constexpr std::size_t c_maxLines{ 256 };
+
+		AppSidebarItem& m_app;
+		Commands m_commands;
+		std::array<char, 256> m_input{};
+		std::vector<std::string> m_lines{};
+
+		void print(const std::string& _text);
+
+	public:
+
+		ConsoleSidebarItem(AppSidebarItem& _app);
+
+		// fired before running, so that the session can be recorded and replayed
+		cpputils::collections::Event<ConsoleSidebarItem, const std::string&> onRun;
+		cpputils::collections::Event<ConsoleSidebarItem, const std::string&> onRunFile;
+
+		void run(const std::string& _line);
+
+		void runFile(const std::string& _filename);
+
+		void runFile();
+
+		void draw() override final;
+
+	};
+
+}
\ No newline at end of file
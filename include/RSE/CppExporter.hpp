@@ -18,9 +18,43 @@ namespace RSE
 		std::string vertListType{ "std::vector<IVec>" };
 		std::string type{ "Scheme" };
 		std::array<std::size_t, 8> polyIndices{ 0,2,3,1,4,6,7,5 };
+		// faces and edges add the unique faces or edges and per-poly indices into them; the per-poly order is written as a comment
+		// in the output, as positions in the exported polys (that is, after polyIndices)
+		bool faces{ false };
+		std::string faceIndsType{ "QuadVertIs" };
+		std::string faceIndsListType{ "std::vector<QuadVertIs>" };
+		std::string polyFacesType{ "HexFaceIs" };
+		std::string polyFacesListType{ "std::vector<HexFaceIs>" };
+		bool edges{ false };
+		std::string edgeIndsType{ "EdgeVertIs" };
+		std::string edgeIndsListType{ "std::vector<EdgeVertIs>" };
+		std::string polyEdgesType{ "HexEdgeIs" };
+		std::string polyEdgesListType{ "std::vector<HexEdgeIs>" };
+
+		struct Source final
+		{
+			std::string name;
+			Int size;
+			std::vector<HexVertsU> children;
+		};
+
+		// a C++ identifier made from the stem of _filename
+		static std::string identifier(const std::string& _filename);
+
+		bool operator==(const CppExporter&) const = default;
 
 		std::string operator()(Int _size, const std::vector<HexVertsU>& _children) const;
 
+		// one definition per source, with the vertices of all the sources of the same size merged into
+		// a single pool named <name>Verts<size>; sources are prepared and formatted in parallel;
+		// a source or pool name that is already taken gets the first free _<n> suffix
+		std::string operator()(const std::vector<Source>& _sources) const;
+
+		// loads the schemes in parallel, drops their duplicate children and writes the combined header atomically;
+		// returns false without touching _output if it was generated from the same inputs and settings or already
+		// holds the same content
+		bool exportFiles(const std::vector<std::string>& _files, const std::string& _output) const;
+
 	};
 
 }
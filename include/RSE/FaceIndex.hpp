@@ -0,0 +1,92 @@
+#pragma once
+
+#include <RSE/types.hpp>
+#include <RSE/hexUtils.hpp>
+#include <vector>
+#include <array>
+#include <optional>
+#include <unordered_map>
+#include <cstddef>
+
+namespace RSE
+{
+
+	// indexes the faces of an external array of hexes, which the owner keeps alive and in sync
+	class FaceIndex final
+	{
+
+	public:
+
+		// hex is a stable id (see index()), so removing a hex does not touch the refs of the others
+		struct FaceRef final
+		{
+			std::size_t hex;
+			std::size_t face;
+		};
+
+		using KeyHasher = hexUtils::VertsHasher;
+
+		using Faces = std::unordered_map<QuadVertsU, std::vector<FaceRef>, KeyHasher>;
+
+	private:
+
+		Faces m_faces;
+		const std::vector<HexVertsU>* m_hexes; // by index
+		std::vector<std::size_t> m_ids; // by index
+		std::vector<std::size_t> m_indices; // by id
+		std::vector<std::size_t> m_freeIds;
+
+		void insert(std::size_t _id, const HexVertsU& _verts);
+
+		void erase(std::size_t _id, const HexVertsU& _verts, std::vector<std::size_t>& _touched);
+
+		// maps the ids in _touched to sorted unique indices
+		std::vector<std::size_t> touchedIndices(std::vector<std::size_t>& _touched) const;
+
+	public:
+
+		static QuadVertsU key(const QuadVertsU& _face);
+
+		static QuadVertsU key(const HexVertsU& _hex, std::size_t _face);
+
+		FaceIndex();
+
+		explicit FaceIndex(const std::vector<HexVertsU>& _hexes);
+
+		FaceIndex(std::vector<HexVertsU>&&) = delete;
+
+		// follows the array after the owner moved or copied it
+		void rebind(const std::vector<HexVertsU>& _hexes);
+
+		std::size_t size() const;
+
+		// estimated heap bytes, hash table nodes included
+		std::size_t bytes() const;
+
+		const HexVertsU& hex(std::size_t _hex) const;
+
+		// index of the hex with id _id
+		std::size_t index(std::size_t _id) const;
+
+		const Faces& faces() const;
+
+		// indexes the last hex of the array
+		void add();
+
+		// the array already holds the new vertices of _hex, _oldVerts are the indexed ones
+		std::vector<std::size_t> update(std::size_t _hex, const HexVertsU& _oldVerts);
+
+		// the array no longer holds _hex, _oldVerts are its indexed vertices
+		std::vector<std::size_t> remove(std::size_t _hex, const HexVertsU& _oldVerts);
+
+		void clear();
+
+		const std::vector<FaceRef>& refs(const QuadVertsU& _face) const;
+
+		std::optional<std::size_t> neighbor(std::size_t _hex, std::size_t _face) const;
+
+		std::array<std::optional<std::size_t>, 6> neighbors(std::size_t _hex) const;
+
+	};
+
+}
\ No newline at end of file
@@ -2,7 +2,8 @@
 
 #include <RSE/types.hpp>
 #include <vector>
-#include <type_traits>
+#include <array>
+#include <cstddef>
 
 namespace RSE
 {
@@ -10,48 +11,73 @@ namespace RSE
 	class Grid final
 	{
 
-	private:
+	public:
 
-		static constexpr bool c_useSingleFp{ true };
+		enum class EPrecision
+		{
+			Single, Double
+		};
 
-		using FastValue = std::conditional_t<c_useSingleFp, float, Real>;
-		using FastVec2 = Vec2<FastValue>;
-		using FastVert = Vec3<FastValue>;
-		using FastHex = HexVertData<FastVert>;
-		using FastQuad = QuadVertData<FastVert>;
-		using FastEdge = EdgeVertData<FastVert>;
+		// zero-copy view of the lattice points as Real vectors
+		class RealPoints final
+		{
 
-		static constexpr bool c_isReal{ std::is_same_v<Real, FastValue> };
+		private:
 
-		template<typename TData>
-		using CastResult = std::conditional_t<c_isReal, const TData&, TData>;
+			friend class Grid;
 
-		std::vector<FastVert> m_points;
-		Int m_size;
+			const Grid& m_grid;
+
+			RealPoints(const Grid& _grid);
 
-		static CastResult<RVec3> cast(const FastVert& _vec);
+		public:
 
-		static CastResult<FastVert> cast(const RVec3& _vec);
+			std::size_t size() const;
 
-		static CastResult<FastVert> cast(const IVec3& _vec);
+			RVec3 operator[](std::size_t _index) const;
 
-		static CastResult<FastHex> cast(const HexVerts& _verts);
+		};
 
-		static FastValue pointLineOffset(const FastVert& _origin, const FastVert& _dir, const FastVert& _point);
+	private:
+
+		template<typename TValue>
+		using Points = std::array<std::vector<TValue>, 3>;
+
+		EPrecision m_precision;
+		Points<float> m_singlePoints;
+		Points<Real> m_doublePoints;
+		HexVerts m_verts;
+		Int m_size;
 
-		static FastValue pointLineSqrDist(const FastVert& _origin, const FastVert& _normDir, const FastVert& _point, bool& _behind);
+		template<typename TValue>
+		const Points<TValue>& points() const;
+
+		template<typename TValue>
+		static void make(Int _size, const HexVerts& _verts, Points<TValue>& _points);
+
+		template<typename TValue>
+		std::size_t closestToRay(const RVec3& _origin, const RVec3& _dir, const IVec3& _min, const IVec3& _max) const;
 
 	public:
 
+		static Real precisionDeviation(Int _size, const HexVerts& _verts);
+
 		Grid();
 
 		Int size() const;
 
+		EPrecision precision() const;
+
+		std::size_t bytes() const;
+
+		void setPrecision(EPrecision _precision);
+
 		void make(Int _size, const HexVerts& _verts);
 
-		const std::vector<FastVert>& points() const;
+		// maximum distance between the single and double precision lattices of the current source
+		Real precisionDeviation() const;
 
-		CastResult<std::vector<RVec3>> realPoints() const;
+		RealPoints realPoints() const;
 
 		std::size_t index(const IVec3& _coords) const;
 
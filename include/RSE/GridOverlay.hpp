@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cinolib/drawable_object.h>
+#include <cinolib/color.h>
+#include <RSE/types.hpp>
+#include <RSE/Grid.hpp>
+#include <vector>
+#include <cstddef>
+
+namespace RSE
+{
+
+	// every unit segment of the lattice, built once per grid;
+	// only the segments inside the cursor box are drawn, as contiguous index ranges
+	class GridOverlay final : public cinolib::DrawableObject
+	{
+
+	private:
+
+		struct Range final
+		{
+			int first;
+			int count;
+		};
+
+		std::vector<float> m_verts{};
+		std::vector<Range> m_ranges{};
+		Int m_size{};
+		RVec3 m_center{};
+		float m_radius{};
+
+		std::size_t segmentIndex(unsigned int _dim, Int _a, Int _b, Int _t) const;
+
+	public:
+
+		cinolib::Color color{ cinolib::Color::WHITE() };
+		float thickness{ 1.0f };
+		bool visible{ true };
+
+		void make(const Grid& _grid);
+
+		std::size_t bytes() const;
+
+		// O(size^2) update of the draw ranges, with no vertex data rebuilt
+		void setCursor(const IVec3& _min, const IVec3& _max);
+
+		cinolib::ObjectType object_type() const override;
+
+		void draw(const float _sceneSize = 1) const override;
+
+		cinolib::vec3d scene_center() const override;
+
+		float scene_radius() const override;
+
+	};
+
+}
\ No newline at end of file
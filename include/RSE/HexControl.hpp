@@ -30,7 +30,7 @@ namespace RSE
 			HexVertData<unsigned char> m_ids;
 			Verts m_verts;
 			bool m_valid;
-			std::size_t m_activeVert;
+			unsigned char m_activeVert;
 
 			void update();
 
@@ -17,18 +17,7 @@ namespace RSE::internal
 	template<bool TInt>
 	void HexControl<TInt>::update()
 	{
-		m_valid = true;
-		for (std::size_t i{}; i < m_verts.size(); i++)
-		{
-			for (std::size_t j{ i + 1 }; j < m_verts.size(); j++)
-			{
-				if (m_verts[i] == m_verts[j])
-				{
-					m_valid = false;
-					return;
-				}
-			}
-		}
+		m_valid = hexUtils::distinctVerts(m_verts);
 	}
 
 	template<bool TInt>
@@ -136,7 +125,7 @@ namespace RSE::internal
 		{
 			throw std::domain_error{ "out of range" };
 		}
-		m_activeVert = _index;
+		m_activeVert = static_cast<unsigned char>(_index);
 	}
 
 	template<bool TInt>
@@ -269,7 +258,7 @@ namespace RSE::internal
 				int activeI{ static_cast<int>(m_activeVert) };
 				if (ImGui::RadioButton("", &activeI, static_cast<int>(i)))
 				{
-					m_activeVert = i;
+					m_activeVert = static_cast<unsigned char>(i);
 				}
 				ImGui::SameLine();
 			}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cinolib/drawable_object.h>
+#include <cinolib/color.h>
+#include <RSE/types.hpp>
+#include <array>
+#include <cstdint>
+
+namespace RSE
+{
+
+	// a single hexahedron drawn from a shared, precomputed topology;
+	// each instance only stores its 8 positions, its color and a face culling mask
+	class HexDrawable final : public cinolib::DrawableObject
+	{
+
+	public:
+
+		// immutable connectivity of a hexahedron in RSE vertex order
+		struct Topology final
+		{
+			// counterclockwise when seen from outside; the flat normal of a face
+			// is the cross product of its diagonals (2 - 0) x (3 - 1)
+			std::array<QuadVertData<unsigned char>, 6> faces;
+			std::array<EdgeVertData<unsigned char>, 12> edges;
+			// the two faces incident to each edge
+			std::array<EdgeVertData<unsigned char>, 12> edgeFaces;
+			// the corner that ends each face in faceLists; flat shading lights a quad with its last vertex,
+			// so the normal of a face is passed on its own corner
+			std::array<unsigned char, 6> faceCorners;
+			// for each face culling mask, the corners of the drawn faces (GL_QUADS) and edges (GL_LINES)
+			std::array<std::array<unsigned char, 6 * 4>, 64> faceLists;
+			std::array<unsigned char, 64> faceListSizes;
+			std::array<std::array<unsigned char, 12 * 2>, 64> edgeLists;
+			std::array<unsigned char, 64> edgeListSizes;
+		};
+
+		static const Topology topology;
+
+	private:
+
+		std::array<float, 8 * 3> m_verts{};
+		cinolib::Color m_color{};
+		std::uint8_t m_culledFaces{};
+		// mirrored hexahedra have clockwise faces
+		bool m_inverted{};
+
+		void faceNormal(std::size_t _face, float* _normal) const;
+
+		// draw calls only; the state is set up once per pass by beginFaces and beginEdges
+		void drawFaces() const;
+		void drawEdges() const;
+
+		static void beginFaces();
+		static void beginEdges();
+		static void end();
+
+		friend class HexDrawableBatch;
+
+	public:
+
+		static constexpr std::uint8_t c_allFaces{ 0b111111 };
+
+		bool visible{ true };
+		bool wireframe{ false };
+
+		void setVerts(const HexVerts& _verts);
+
+		void setColor(const cinolib::Color& _color);
+
+		// one bit per face, in hexUtils::hexFaceInds order; an edge is drawn unless both its faces are culled
+		void setCulledFaces(std::uint8_t _faces);
+
+		std::uint8_t culledFaces() const;
+
+		cinolib::ObjectType object_type() const override;
+
+		void draw(const float _sceneSize = 1) const override;
+
+		cinolib::vec3d scene_center() const override;
+
+		float scene_radius() const override;
+
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cinolib/drawable_object.h>
+#include <RSE/HexDrawable.hpp>
+#include <vector>
+
+namespace RSE
+{
+
+	// draws a list of HexDrawables in two passes, faces then edges, setting up the GL state once per pass
+	// instead of once per hexahedron; the hexahedra themselves must not be pushed to the canvas
+	class HexDrawableBatch final : public cinolib::DrawableObject
+	{
+
+	private:
+
+		const std::vector<HexDrawable*>& m_hexes;
+
+	public:
+
+		explicit HexDrawableBatch(const std::vector<HexDrawable*>& _hexes);
+
+		cinolib::ObjectType object_type() const override;
+
+		void draw(const float _sceneSize = 1) const override;
+
+		cinolib::vec3d scene_center() const override;
+
+		float scene_radius() const override;
+
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <RSE/types.hpp>
+#include <vector>
+#include <map>
+#include <string>
+#include <optional>
+#include <istream>
+#include <ostream>
+#include <cstdint>
+
+namespace RSE
+{
+
+	// timestamped input and model events of an editing session;
+	// console lines and scripts are logged as commands, other sidebar actions only through their model events
+	struct InputLog final
+	{
+
+		enum class EType
+		{
+			Key, MouseRay, Click, Model, Command, Script
+		};
+
+		enum class EModelEvent
+		{
+			SourceUpdate, CursorUpdate, ChildrenClear, ChildAdd, ChildRemove, ChildUpdate, ChildrenUpdate
+		};
+
+		struct Event final
+		{
+			EType type;
+			std::int64_t microseconds{};
+			int key{};
+			int modifiers{};
+			RVec3 origin{};
+			RVec3 dir{};
+			// the command line or script filename
+			std::string text{};
+		};
+
+		std::optional<std::string> file{};
+		std::vector<Event> events{};
+
+		void write(std::ostream& _stream) const;
+
+		static InputLog read(std::istream& _stream);
+
+		void save(const std::string& _filename) const;
+
+		static InputLog load(const std::string& _filename);
+
+	};
+
+	// per handler latency samples
+	struct LatencyReport final
+	{
+		std::map<std::string, std::vector<Real>> seconds{};
+		std::size_t recordedModelEvents{};
+		std::size_t replayedModelEvents{};
+
+		void add(const std::string& _handler, Real _seconds);
+	};
+
+	std::ostream& operator<<(std::ostream& _stream, const LatencyReport& _report);
+
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cinolib/gl/side_bar_item.h>
+#include <RSE/AppSidebarItem.hpp>
+#include <RSE/SchemeLibrary.hpp>
+#include <string>
+#include <unordered_map>
+
+namespace RSE
+{
+
+	class LibrarySidebarItem final : public cinolib::SideBarItem
+	{
+
+	private:
+
+		AppSidebarItem& m_app;
+		SchemeLibrary m_library;
+		std::unordered_map<std::string, unsigned int> m_textures;
+
+		void clearTextures();
+
+	public:
+
+		LibrarySidebarItem(AppSidebarItem& _app);
+
+		LibrarySidebarItem(const LibrarySidebarItem&) = delete;
+
+		LibrarySidebarItem& operator=(const LibrarySidebarItem&) = delete;
+
+		~LibrarySidebarItem();
+
+		void open(const std::string& _directory);
+
+		void open();
+
+		void draw() override final;
+
+	};
+
+}
\ No newline at end of file
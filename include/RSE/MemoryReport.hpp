@@ -0,0 +1,42 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <ostream>
+
+namespace RSE
+{
+
+	// bytes owned by each subsystem, estimated from object sizes and container capacities
+	// (allocator overhead excluded)
+	struct MemoryReport final
+	{
+		struct Entry final
+		{
+			std::size_t count;
+			std::size_t bytes;
+		};
+
+		std::map<std::string, Entry> subsystems{};
+
+		void add(const std::string& _subsystem, std::size_t _count, std::size_t _bytes);
+
+		std::size_t bytes() const;
+
+		template<typename TData>
+		static std::size_t bytes(const std::vector<TData>& _vector)
+		{
+			return _vector.capacity() * sizeof(TData);
+		}
+
+		static std::size_t bytes(const std::vector<bool>& _vector)
+		{
+			return _vector.capacity() / 8;
+		}
+	};
+
+	std::ostream& operator<<(std::ostream& _stream, const MemoryReport& _report);
+
+}
\ No newline at end of file
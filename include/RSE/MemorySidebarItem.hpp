@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cinolib/gl/side_bar_item.h>
+#include <RSE/MemoryReport.hpp>
+#include <cpputils/collections/Event.hpp>
+#include <optional>
+
+namespace RSE
+{
+
+	class MemorySidebarItem final : public cinolib::SideBarItem
+	{
+
+	private:
+
+		std::optional<MemoryReport> m_report{};
+
+	public:
+
+		MemorySidebarItem();
+
+		// listeners add their subsystems to the report
+		cpputils::collections::Event<MemorySidebarItem, MemoryReport&> onReport;
+
+		const MemoryReport& refresh();
+
+		void draw() override final;
+
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cinolib/gl/side_bar_item.h>
+#include <RSE/AppSidebarItem.hpp>
+#include <RSE/Refiner.hpp>
+#include <string>
+#include <optional>
+#include <cstddef>
+#include <cpputils/collections/Event.hpp>
+
+namespace RSE
+{
+
+	class PreviewSidebarItem final : public cinolib::SideBarItem
+	{
+
+	private:
+
+		const AppSidebarItem& m_app;
+		std::optional<std::string> m_file{};
+		Refiner::Mesh m_source{};
+		std::optional<Refiner::Mesh> m_mesh{};
+		Real m_hexesPerSecond{};
+
+	public:
+
+		PreviewSidebarItem(const AppSidebarItem& _app);
+
+		cpputils::collections::Event<PreviewSidebarItem> onMeshUpdate;
+
+		const std::optional<std::string>& file() const;
+
+		const Refiner::Mesh& source() const;
+
+		const std::optional<Refiner::Mesh>& mesh() const;
+
+		Real hexesPerSecond() const;
+
+		void load(const std::string& _filename);
+
+		void load();
+
+		void refine();
+
+		void clear();
+
+		void draw() override final;
+
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <RSE/types.hpp>
+#include <vector>
+#include <array>
+#include <cstddef>
+
+namespace RSE
+{
+
+	struct Refiner final
+	{
+
+		struct Mesh final
+		{
+			std::vector<RVec3> verts{};
+			std::vector<HexVertData<std::size_t>> hexes{};
+		};
+
+		// refined vertices are indexed by the lattice of the source vertex, edge, face or hex they lie on,
+		// so shared vertices are stitched without hashing and child hexes can be streamed per source hex
+		class Refinement final
+		{
+
+		private:
+
+			friend struct Refiner;
+
+			enum class EPointType
+			{
+				Corner, Edge, Face, Interior
+			};
+
+			struct Point final
+			{
+				IVec3 coord;
+				EPointType type;
+				std::size_t entity;
+			};
+
+			const Mesh* m_source{};
+			Int m_size{};
+			std::vector<Point> m_points{};
+			std::vector<HexVertData<std::size_t>> m_children{};
+			std::size_t m_interiorCount{};
+			std::vector<std::array<std::size_t, 12>> m_hexEdges{};
+			std::vector<std::array<std::size_t, 6>> m_hexFaces{};
+			std::vector<EdgeVertData<std::size_t>> m_edges{};
+			std::vector<QuadVertData<std::size_t>> m_faces{};
+			std::vector<std::size_t> m_slots{};
+			std::size_t m_boundaryVertCount{};
+			std::vector<RVec3> m_verts{};
+
+			std::size_t slot(std::size_t _hex, const Point& _point) const;
+
+		public:
+
+			const std::vector<RVec3>& verts() const;
+
+			std::size_t sourceHexCount() const;
+
+			std::size_t hexCount() const;
+
+			// point indices of each child
+			const std::vector<HexVertData<std::size_t>>& children() const;
+
+			std::size_t pointCount() const;
+
+			// refined vertex index of each scheme point inside the source hex
+			void pointVerts(std::size_t _sourceHex, std::size_t* _out) const;
+
+			Mesh mesh() const;
+
+		};
+
+		// the source mesh must outlive the refinement
+		Refinement operator()(Int _size, const std::vector<HexVertsU>& _children, const Mesh& _source) const;
+
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <RSE/types.hpp>
+#include <vector>
+#include <deque>
+#include <map>
+#include <string>
+#include <optional>
+#include <cstdint>
+#include <cstddef>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace RSE
+{
+
+	// indexes the .rse files of a directory, keeping their header data in an index file and their thumbnails
+	// in a sidecar file, and parsing only the files whose mtime changed in a background thread
+	class SchemeLibrary final
+	{
+
+	public:
+
+		static constexpr int c_thumbnailSize{ 96 };
+		static constexpr const char* c_indexFilename{ ".rse-library" };
+		static constexpr const char* c_thumbnailsFilename{ ".rse-thumbnails" };
+
+		struct Entry final
+		{
+			std::string filename;
+			std::int64_t mtime;
+			Int size;
+			std::size_t childCount;
+			bool valid;
+		};
+
+		struct Thumbnail final
+		{
+			std::string filename;
+			std::vector<unsigned char> pixels;
+		};
+
+	private:
+
+		// run-length encoded pixels of the file version with the given mtime, empty if the file could not be read
+		struct CachedThumbnail final
+		{
+			std::int64_t mtime;
+			std::vector<unsigned char> encoded;
+		};
+
+		struct Job final
+		{
+			std::string filename;
+			std::int64_t mtime;
+			bool parse;
+		};
+
+		struct Result final
+		{
+			std::size_t generation;
+			std::optional<Entry> entry;
+			Thumbnail thumbnail;
+			CachedThumbnail cached;
+		};
+
+		std::string m_directory;
+		std::vector<Entry> m_entries;
+		std::map<std::string, CachedThumbnail> m_thumbnails;
+		std::vector<Thumbnail> m_cachedThumbnails;
+		std::size_t m_pending;
+		bool m_indexDirty, m_thumbnailsDirty;
+		mutable std::mutex m_mutex;
+		std::condition_variable m_condition;
+		std::deque<Job> m_jobs;
+		std::vector<Result> m_results;
+		std::size_t m_generation;
+		bool m_stop;
+		std::thread m_thread;
+
+		void run();
+		void readIndex();
+		void writeIndex() const;
+		void readThumbnails();
+		void writeThumbnails() const;
+
+	public:
+
+		// RGBA image of the children edges seen from an oblique view
+		static std::vector<unsigned char> renderThumbnail(Int _size, const std::vector<HexVertsU>& _children);
+
+		SchemeLibrary();
+
+		SchemeLibrary(const SchemeLibrary&) = delete;
+
+		SchemeLibrary& operator=(const SchemeLibrary&) = delete;
+
+		~SchemeLibrary();
+
+		void open(const std::string& _directory);
+
+		const std::string& directory() const;
+
+		const std::vector<Entry>& entries() const;
+
+		std::string path(const Entry& _entry) const;
+
+		bool busy() const;
+
+		// applies the finished background work and returns the new thumbnails
+		std::vector<Thumbnail> poll();
+
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <RSE/types.hpp>
+#include <vector>
+#include <cstddef>
+#include <ostream>
+
+namespace RSE
+{
+
+	struct SchemeValidator final
+	{
+
+		struct Report final
+		{
+			std::size_t cells{};
+			std::size_t gapCells{};
+			std::size_t overlapCells{};
+			std::size_t invalidChildren{};
+			std::size_t nonConformingFaces{};
+
+			bool valid() const;
+
+		};
+
+		Int resolution{ 4 };
+
+		Report operator()(Int _size, const std::vector<HexVertsU>& _children) const;
+
+	};
+
+	std::ostream& operator<<(std::ostream& _stream, const SchemeValidator::Report& _report);
+
+}
\ No newline at end of file
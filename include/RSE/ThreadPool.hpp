@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+
+namespace RSE
+{
+
+	// each worker owns a deque: it pops its own tasks from the back and steals from the front of the others
+	class ThreadPool final
+	{
+
+	public:
+
+		using Task = std::function<void()>;
+
+	private:
+
+		struct Queue final
+		{
+			std::mutex mutex;
+			std::deque<Task> tasks;
+		};
+
+		std::vector<std::unique_ptr<Queue>> m_queues;
+		std::vector<std::thread> m_threads;
+		std::mutex m_mutex;
+		std::condition_variable m_condition;
+		std::atomic<std::size_t> m_pending;
+		std::atomic<std::size_t> m_next;
+		bool m_stop;
+
+		std::size_t queueIndex();
+		bool runOne(std::size_t _queue);
+		void run(std::size_t _queue);
+
+	public:
+
+		static ThreadPool& shared();
+
+		explicit ThreadPool(std::size_t _threadCount);
+
+		ThreadPool(const ThreadPool&) = delete;
+
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		~ThreadPool();
+
+		std::size_t size() const;
+
+		void submit(Task _task);
+
+		template<typename TFunc>
+		void forEachChunk(std::size_t _count, std::size_t _chunkSize, const TFunc& _func);
+
+	};
+
+}
+
+#define RSE_THREADPOOL_TPP
+#include <RSE/ThreadPool.tpp>
+#undef RSE_THREADPOOL_TPP
\ No newline at end of file
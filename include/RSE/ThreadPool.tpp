@@ -0,0 +1,46 @@
+#ifndef RSE_THREADPOOL_TPP
+#error __FILE__ cannot be included directly
+#endif
+
+#include <RSE/ThreadPool.hpp>
+
+#include <algorithm>
+
+namespace RSE
+{
+
+	template<typename TFunc>
+	void ThreadPool::forEachChunk(std::size_t _count, std::size_t _chunkSize, const TFunc& _func)
+	{
+		_chunkSize = std::max<std::size_t>(_chunkSize, 1);
+		const std::size_t chunks{ (_count + _chunkSize - 1) / _chunkSize };
+		if (chunks <= 1 || m_threads.empty())
+		{
+			if (_count)
+			{
+				_func(std::size_t{ 0 }, _count);
+			}
+			return;
+		}
+		std::atomic<std::size_t> remaining{ chunks };
+		for (std::size_t chunk{ 1 }; chunk < chunks; chunk++)
+		{
+			submit([&_func, &remaining, chunk, _chunkSize, _count]() {
+				const std::size_t begin{ chunk * _chunkSize };
+				_func(begin, std::min(begin + _chunkSize, _count));
+				remaining--;
+			});
+		}
+		_func(std::size_t{ 0 }, std::min(_chunkSize, _count));
+		remaining--;
+		const std::size_t queue{ queueIndex() };
+		while (remaining)
+		{
+			if (!runOne(queue))
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+}
\ No newline at end of file
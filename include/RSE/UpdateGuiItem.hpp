@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cinolib/gl/canvas_gui_item.h>
+#include <cpputils/collections/Event.hpp>
+
+namespace RSE
+{
+
+	class UpdateGuiItem final : public cinolib::CanvasGuiItem
+	{
+
+	public:
+
+		UpdateGuiItem();
+
+		cpputils::collections::Event<UpdateGuiItem> onUpdate;
+
+		void draw() override;
+
+	};
+
+}
\ No newline at end of file
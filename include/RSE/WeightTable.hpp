@@ -0,0 +1,45 @@
+#pragma once
+
+#include <RSE/types.hpp>
+#include <vector>
+#include <array>
+#include <memory>
+#include <cstddef>
+
+namespace RSE
+{
+
+	// trilinear weights of the 8 hex corners at a fixed set of points, stored per corner so that
+	// evaluating a hex is a plain weighted sum over contiguous arrays
+	template<typename TValue>
+	class WeightTable final
+	{
+
+	private:
+
+		std::array<std::vector<TValue>, 8> m_weights;
+
+	public:
+
+		// shared table of the (_size + 1)^3 lattice points in grid index order
+		static std::shared_ptr<const WeightTable> lattice(Int _size);
+
+		explicit WeightTable(const std::vector<Vec3<TValue>>& _coords);
+
+		WeightTable(const WeightTable& _table, const std::vector<std::size_t>& _indices);
+
+		std::size_t size() const;
+
+		const std::vector<TValue>& weights(std::size_t _corner) const;
+
+		void apply(const HexVertData<Vec3<TValue>>& _hex, TValue* _x, TValue* _y, TValue* _z) const;
+
+		void apply(const HexVertData<Vec3<TValue>>& _hex, Vec3<TValue>* _out) const;
+
+	};
+
+}
+
+#define RSE_WEIGHTTABLE_TPP
+#include <RSE/WeightTable.tpp>
+#undef RSE_WEIGHTTABLE_TPP
\ No newline at end of file
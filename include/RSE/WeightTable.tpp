@@ -0,0 +1,127 @@
+#ifndef RSE_WEIGHTTABLE_TPP
+#error __FILE__ cannot be included directly
+#endif
+
+#include <RSE/WeightTable.hpp>
+
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+namespace RSE
+{
+
+	template<typename TValue>
+	std::shared_ptr<const WeightTable<TValue>> WeightTable<TValue>::lattice(Int _size)
+	{
+		if (_size < 1)
+		{
+			throw std::logic_error{ "size must be positive" };
+		}
+		static std::mutex mutex{};
+		static std::map<Int, std::shared_ptr<const WeightTable>> cache{};
+		const std::lock_guard lock{ mutex };
+		std::shared_ptr<const WeightTable>& table{ cache[_size] };
+		if (!table)
+		{
+			const Int layers{ _size + 1 };
+			std::vector<Vec3<TValue>> coords{};
+			coords.reserve(static_cast<std::size_t>(layers * layers * layers));
+			for (Int z{}; z < layers; z++)
+			{
+				for (Int y{}; y < layers; y++)
+				{
+					for (Int x{}; x < layers; x++)
+					{
+						coords.push_back(IVec3{ x, y, z }.template cast<TValue>() / static_cast<TValue>(_size));
+					}
+				}
+			}
+			table = std::make_shared<const WeightTable>(coords);
+		}
+		return table;
+	}
+
+	template<typename TValue>
+	WeightTable<TValue>::WeightTable(const std::vector<Vec3<TValue>>& _coords) : m_weights{}
+	{
+		for (std::vector<TValue>& weights : m_weights)
+		{
+			weights.resize(_coords.size());
+		}
+		for (std::size_t p{}; p < _coords.size(); p++)
+		{
+			for (std::size_t i{}; i < 8; i++)
+			{
+				TValue weight{ 1 };
+				for (unsigned int d{}; d < 3; d++)
+				{
+					weight *= (i >> d) & 1 ? _coords[p][d] : 1 - _coords[p][d];
+				}
+				m_weights[i][p] = weight;
+			}
+		}
+	}
+
+	template<typename TValue>
+	WeightTable<TValue>::WeightTable(const WeightTable& _table, const std::vector<std::size_t>& _indices) : m_weights{}
+	{
+		for (std::size_t i{}; i < 8; i++)
+		{
+			m_weights[i].reserve(_indices.size());
+			for (const std::size_t index : _indices)
+			{
+				m_weights[i].push_back(_table.m_weights[i][index]);
+			}
+		}
+	}
+
+	template<typename TValue>
+	std::size_t WeightTable<TValue>::size() const
+	{
+		return m_weights[0].size();
+	}
+
+	template<typename TValue>
+	const std::vector<TValue>& WeightTable<TValue>::weights(std::size_t _corner) const
+	{
+		return m_weights[_corner];
+	}
+
+	template<typename TValue>
+	void WeightTable<TValue>::apply(const HexVertData<Vec3<TValue>>& _hex, TValue* _x, TValue* _y, TValue* _z) const
+	{
+		const std::size_t count{ size() };
+		for (std::size_t p{}; p < count; p++)
+		{
+			_x[p] = _y[p] = _z[p] = 0;
+		}
+		for (std::size_t i{}; i < 8; i++)
+		{
+			const TValue* const weights{ m_weights[i].data() };
+			const TValue x{ _hex[i].x() }, y{ _hex[i].y() }, z{ _hex[i].z() };
+			for (std::size_t p{}; p < count; p++)
+			{
+				_x[p] += weights[p] * x;
+				_y[p] += weights[p] * y;
+				_z[p] += weights[p] * z;
+			}
+		}
+	}
+
+	template<typename TValue>
+	void WeightTable<TValue>::apply(const HexVertData<Vec3<TValue>>& _hex, Vec3<TValue>* _out) const
+	{
+		const std::size_t count{ size() };
+		for (std::size_t p{}; p < count; p++)
+		{
+			Vec3<TValue> point{ 0,0,0 };
+			for (std::size_t i{}; i < 8; i++)
+			{
+				point += _hex[i] * m_weights[i][p];
+			}
+			_out[p] = point;
+		}
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <RSE/types.hpp>
+#include <RSE/hexUtils.hpp>
+#include <vector>
+#include <string>
+#include <array>
+
+namespace RSE::generators
+{
+
+	enum class EFamily
+	{
+		Uniform, Graded, Transition3, Transition27
+	};
+
+	constexpr std::array<const char*, 4> familyNames{ "uniform", "graded", "transition3", "transition27" };
+
+	struct Params final
+	{
+		EFamily family{ EFamily::Uniform };
+		Int cellSize{ 1 };
+		// graded and transition3: direction of refinement (finer toward _min for graded, toward _max for transition3)
+		hexUtils::EDim dim{ hexUtils::EDim::Z };
+		// transition3: direction along which the fine face is split in three
+		hexUtils::EDim splitDim{ hexUtils::EDim::X };
+	};
+
+	// cubes of side _cellSize tiling the box; cells that do not fit are left out
+	std::vector<HexVertsU> uniform(const IVec3& _min, const IVec3& _max, Int _cellSize);
+
+	// slabs along _dim that double in thickness from _min, each tiled with cubes as thick as the slab
+	std::vector<HexVertsU> graded(const IVec3& _min, const IVec3& _max, Int _cellSize, hexUtils::EDim _dim);
+
+	// one row of 1-to-3 templates of side 3 * _cellSize along _splitDim and _fineDim, with the fine face toward _max along _fineDim,
+	// extruded along the remaining dimension in layers of _cellSize
+	std::vector<HexVertsU> transition3(const IVec3& _min, const IVec3& _max, Int _cellSize, hexUtils::EDim _fineDim, hexUtils::EDim _splitDim);
+
+	// blocks of side 3 * _cellSize each split into 27 cubes
+	std::vector<HexVertsU> transition27(const IVec3& _min, const IVec3& _max, Int _cellSize);
+
+	// generates the family in the box and checks the result for hexes with coincident vertices,
+	// throwing std::logic_error if any is found
+	std::vector<HexVertsU> generate(const IVec3& _min, const IVec3& _max, const Params& _params);
+
+}
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include <RSE/types.hpp>
 #include <cstddef>
+#include <span>
 
 namespace RSE::hexUtils
 {
@@ -17,8 +18,29 @@ namespace RSE::hexUtils
 	template<typename TValue>
 	HexVertData<Vec3<TValue>> sortVerts(const HexVertData<Vec3<TValue>>& _verts);
 
+	// false if any two corners coincide
+	template<typename TValue>
+	bool distinctVerts(const HexVertData<Vec3<TValue>>& _verts);
+
 	constexpr HexVertData<std::size_t> cinolibHexInds{ 0,1,3,2, 4,5,7,6 };
 
+	// x-, x+, y-, y+, z-, z+ (counterclockwise when seen from outside)
+	constexpr std::array<QuadVertData<std::size_t>, 6> hexFaceInds{
+		QuadVertData<std::size_t>{0,4,6,2}, QuadVertData<std::size_t>{1,3,7,5},
+		QuadVertData<std::size_t>{0,1,5,4}, QuadVertData<std::size_t>{2,6,7,3},
+		QuadVertData<std::size_t>{0,2,3,1}, QuadVertData<std::size_t>{4,5,7,6}
+	};
+
+	// x, y, z
+	constexpr std::array<EdgeVertData<std::size_t>, 12> hexEdgeInds{
+		EdgeVertData<std::size_t>{0,1}, EdgeVertData<std::size_t>{2,3}, EdgeVertData<std::size_t>{4,5}, EdgeVertData<std::size_t>{6,7},
+		EdgeVertData<std::size_t>{0,2}, EdgeVertData<std::size_t>{1,3}, EdgeVertData<std::size_t>{4,6}, EdgeVertData<std::size_t>{5,7},
+		EdgeVertData<std::size_t>{0,4}, EdgeVertData<std::size_t>{1,5}, EdgeVertData<std::size_t>{2,6}, EdgeVertData<std::size_t>{3,7}
+	};
+
+	template<typename TValue>
+	QuadVertData<Vec3<TValue>> faceVerts(const HexVertData<Vec3<TValue>>& _verts, std::size_t _face);
+
 	template<typename TValue>
 	HexVertData<Vec3<TValue>> indexVerts(const HexVertData<Vec3<TValue>>& _verts, const HexVertData<std::size_t>& _indices);
 
@@ -37,6 +59,31 @@ namespace RSE::hexUtils
 	template<typename TValue>
 	void translateVerts(HexVertData<Vec3<TValue>>& _verts, const Vec3<TValue>& _offset);
 
+	// out[i][d] = in[_inds[i]][_axes[d]] * _scales[d] + _offsets[d]
+	template<typename TValue>
+	void mapVerts(std::span<HexVertData<Vec3<TValue>>> _hexes, const HexVertData<std::size_t>& _inds, const std::array<unsigned int, 3>& _axes, const Vec3<TValue>& _scales, const Vec3<TValue>& _offsets);
+
+	template<typename TValue>
+	void flipVerts(std::span<HexVertData<Vec3<TValue>>> _hexes, EDim _dim, TValue _doubleMid);
+
+	template<typename TValue>
+	void rotateVerts(std::span<HexVertData<Vec3<TValue>>> _hexes, EDim _dim, TValue _doubleMid);
+
+	template<typename TValue>
+	void scaleVerts(std::span<HexVertData<Vec3<TValue>>> _hexes, const Vec3<TValue>& _scale);
+
+	template<typename TValue>
+	void translateVerts(std::span<HexVertData<Vec3<TValue>>> _hexes, const Vec3<TValue>& _offset);
+
+	// hash of an integer vertex, or order-sensitive hash of a fixed list of them (hexes, faces)
+	struct VertsHasher final
+	{
+		std::size_t operator()(const IVec3& _vert) const;
+
+		template<std::size_t TSize>
+		std::size_t operator()(const std::array<IVec3, TSize>& _verts) const;
+	};
+
 }
 
 #define RSE_HEXUTILS_TPP
@@ -28,6 +28,22 @@ namespace RSE::hexUtils
 		return _verts;
 	}
 
+	template<typename TValue>
+	bool distinctVerts(const HexVertData<Vec3<TValue>>& _verts)
+	{
+		for (std::size_t i{}; i < _verts.size(); i++)
+		{
+			for (std::size_t j{ i + 1 }; j < _verts.size(); j++)
+			{
+				if (_verts[i] == _verts[j])
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
 	template<typename TValue>
 	HexVertData<Vec3<TValue>> indexVerts(const HexVertData<Vec3<TValue>>& _verts, const HexVertData<std::size_t>& _indices)
 	{
@@ -39,6 +55,17 @@ namespace RSE::hexUtils
 		return out;
 	}
 
+	template<typename TValue>
+	QuadVertData<Vec3<TValue>> faceVerts(const HexVertData<Vec3<TValue>>& _verts, std::size_t _face)
+	{
+		QuadVertData<Vec3<TValue>> out;
+		for (std::size_t i{}; i < 4; i++)
+		{
+			out[i] = _verts[hexFaceInds[_face][i]];
+		}
+		return out;
+	}
+
 	template<typename TValue>
 	void flipVerts(HexVertData<Vec3<TValue>>& _verts, EDim _dim, TValue _doubleMid)
 	{
@@ -115,5 +142,87 @@ namespace RSE::hexUtils
 		}
 	}
 
-}
+	template<typename TValue>
+	void mapVerts(std::span<HexVertData<Vec3<TValue>>> _hexes, const HexVertData<std::size_t>& _inds, const std::array<unsigned int, 3>& _axes, const Vec3<TValue>& _scales, const Vec3<TValue>& _offsets)
+	{
+		for (HexVertData<Vec3<TValue>>& hex : _hexes)
+		{
+			const HexVertData<Vec3<TValue>> in{ hex };
+			for (std::size_t i{}; i < 8; i++)
+			{
+				const Vec3<TValue>& vert{ in[_inds[i]] };
+				for (unsigned int d{}; d < 3; d++)
+				{
+					hex[i][d] = vert[_axes[d]] * _scales[d] + _offsets[d];
+				}
+			}
+		}
+	}
+
+	template<typename TValue>
+	void flipVerts(std::span<HexVertData<Vec3<TValue>>> _hexes, EDim _dim, TValue _doubleMid)
+	{
+		static constexpr std::array<HexVertData<std::size_t>, 3> inds{
+			HexVertData<std::size_t>{1,0,3,2,5,4,7,6},
+			HexVertData<std::size_t>{2,3,0,1,6,7,4,5},
+			HexVertData<std::size_t>{4,5,6,7,0,1,2,3}
+		};
+		const unsigned int dim{ static_cast<unsigned int>(_dim) };
+		Vec3<TValue> scales{ 1,1,1 }, offsets{ 0,0,0 };
+		scales[dim] = static_cast<TValue>(-1);
+		offsets[dim] = _doubleMid;
+		mapVerts(_hexes, inds[dim], { 0,1,2 }, scales, offsets);
+	}
+
+	template<typename TValue>
+	void rotateVerts(std::span<HexVertData<Vec3<TValue>>> _hexes, EDim _dim, TValue _doubleMid)
+	{
+		static constexpr std::array<HexVertData<std::size_t>, 3> inds{
+			HexVertData<std::size_t>{4,5,0,1,6,7,2,3},
+			HexVertData<std::size_t>{1,5,3,7,0,4,2,6},
+			HexVertData<std::size_t>{2,0,3,1,6,4,7,5}
+		};
+		static constexpr std::array<std::array<unsigned int, 3>, 3> axes{
+			std::array<unsigned int, 3>{0,2,1},
+			std::array<unsigned int, 3>{2,1,0},
+			std::array<unsigned int, 3>{1,0,2}
+		};
+		const unsigned int dim{ static_cast<unsigned int>(_dim) };
+		// the axis following the rotation axis is mirrored
+		const unsigned int mirrored{ (dim + 1) % 3 };
+		Vec3<TValue> scales{ 1,1,1 }, offsets{ 0,0,0 };
+		scales[mirrored] = static_cast<TValue>(-1);
+		offsets[mirrored] = _doubleMid;
+		mapVerts(_hexes, inds[dim], axes[dim], scales, offsets);
+	}
+
+	template<typename TValue>
+	void scaleVerts(std::span<HexVertData<Vec3<TValue>>> _hexes, const Vec3<TValue>& _scale)
+	{
+		mapVerts(_hexes, { 0,1,2,3,4,5,6,7 }, { 0,1,2 }, _scale, Vec3<TValue>{ 0,0,0 });
+	}
+
+	template<typename TValue>
+	void translateVerts(std::span<HexVertData<Vec3<TValue>>> _hexes, const Vec3<TValue>& _offset)
+	{
+		mapVerts(_hexes, { 0,1,2,3,4,5,6,7 }, { 0,1,2 }, Vec3<TValue>{ 1,1,1 }, _offset);
+	}
+
+	inline std::size_t VertsHasher::operator()(const IVec3& _vert) const
+	{
+		// unsigned arithmetic, so large or negative coordinates wrap instead of overflowing
+		return static_cast<std::size_t>(_vert.x()) * 73856093u ^ static_cast<std::size_t>(_vert.y()) * 19349663u ^ static_cast<std::size_t>(_vert.z()) * 83492791u;
+	}
+
+	template<std::size_t TSize>
+	std::size_t VertsHasher::operator()(const std::array<IVec3, TSize>& _verts) const
+	{
+		std::size_t hash{};
+		for (const IVec3& vert : _verts)
+		{
+			hash = hash * 31 + (*this)(vert);
+		}
+		return hash;
+	}
 
+}
\ No newline at end of file
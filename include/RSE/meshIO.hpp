@@ -0,0 +1,21 @@
+#pragma once
+
+#include <RSE/Refiner.hpp>
+#include <string>
+#include <istream>
+#include <ostream>
+
+// MEDIT (.mesh) hexmesh IO
+namespace RSE::meshIO
+{
+
+	Refiner::Mesh read(std::istream& _stream);
+
+	Refiner::Mesh load(const std::string& _filename);
+
+	// child hexes are formatted in parallel blocks and written as they are produced
+	void write(std::ostream& _stream, const Refiner::Refinement& _refinement);
+
+	void save(const std::string& _filename, const Refiner::Refinement& _refinement);
+
+}
\ No newline at end of file
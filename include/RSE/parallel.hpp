@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+
+namespace RSE::parallel
+{
+
+	inline std::size_t threadCount();
+
+	template<typename TFunc>
+	void forEach(std::size_t _count, const TFunc& _func);
+
+	template<typename TFunc>
+	void forEachChunk(std::size_t _count, std::size_t _chunkSize, const TFunc& _func);
+
+}
+
+#define RSE_PARALLEL_TPP
+#include <RSE/parallel.tpp>
+#undef RSE_PARALLEL_TPP
\ No newline at end of file
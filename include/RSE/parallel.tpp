@@ -0,0 +1,36 @@
+#ifndef RSE_PARALLEL_TPP
+#error __FILE__ cannot be included directly
+#endif
+
+#include <RSE/parallel.hpp>
+
+#include <RSE/ThreadPool.hpp>
+#include <thread>
+#include <algorithm>
+
+namespace RSE::parallel
+{
+
+	inline std::size_t threadCount()
+	{
+		return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+	}
+
+	template<typename TFunc>
+	void forEachChunk(std::size_t _count, std::size_t _chunkSize, const TFunc& _func)
+	{
+		ThreadPool::shared().forEachChunk(_count, _chunkSize, _func);
+	}
+
+	template<typename TFunc>
+	void forEach(std::size_t _count, const TFunc& _func)
+	{
+		forEachChunk(_count, std::max<std::size_t>(_count / (threadCount() * 8), 1), [&_func](std::size_t _begin, std::size_t _end) {
+			for (std::size_t i{ _begin }; i < _end; i++)
+			{
+				_func(i);
+			}
+		});
+	}
+
+}
\ No newline at end of file
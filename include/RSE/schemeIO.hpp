@@ -0,0 +1,34 @@
+#pragma once
+
+#include <RSE/types.hpp>
+#include <vector>
+#include <string>
+#include <istream>
+#include <ostream>
+#include <functional>
+
+namespace RSE::schemeIO
+{
+
+	struct Scheme final
+	{
+		Int size{};
+		std::vector<HexVertsU> children{};
+	};
+
+	void write(std::ostream& _stream, Int _size, const std::vector<HexVertsU>& _children);
+
+	// throws std::runtime_error if the stream ends or fails before the whole scheme is read
+	Scheme read(std::istream& _stream);
+
+	// throws std::logic_error unless _size is positive and every vertex lies in [0, _size]
+	void validate(Int _size, const std::vector<HexVertsU>& _children);
+
+	// written atomically; throws if the file cannot be written
+	void save(const std::string& _filename, Int _size, const std::vector<HexVertsU>& _children);
+
+	Scheme load(const std::string& _filename);
+
+	void writeAtomic(const std::string& _filename, const std::function<void(std::ostream&)>& _write, bool _binary = false);
+
+}
\ No newline at end of file
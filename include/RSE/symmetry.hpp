@@ -0,0 +1,87 @@
+#pragma once
+
+#include <RSE/types.hpp>
+#include <RSE/hexUtils.hpp>
+#include <array>
+#include <span>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace RSE::symmetry
+{
+
+	// x'[d] = _mirrored[d] ? size - x[axes[d]] : x[axes[d]], with corners reordered by inds
+	struct Symmetry final
+	{
+		std::array<unsigned int, 3> axes;
+		std::array<bool, 3> mirrored;
+		HexVertData<std::size_t> inds;
+	};
+
+	namespace internal
+	{
+
+		constexpr Symmetry makeSymmetry(const std::array<unsigned int, 3>& _axes, std::size_t _mirrorBits)
+		{
+			Symmetry symmetry{ _axes, {}, {} };
+			for (unsigned int d{}; d < 3; d++)
+			{
+				symmetry.mirrored[d] = (_mirrorBits >> d) & 1;
+			}
+			// inds[i] is the corner mapped onto corner i
+			for (std::size_t j{}; j < 8; j++)
+			{
+				std::size_t i{};
+				for (unsigned int d{}; d < 3; d++)
+				{
+					const std::size_t bit{ (j >> _axes[d]) & 1 };
+					i |= (symmetry.mirrored[d] ? 1 - bit : bit) << d;
+				}
+				symmetry.inds[i] = j;
+			}
+			return symmetry;
+		}
+
+		constexpr std::array<Symmetry, 48> makeSymmetries()
+		{
+			constexpr std::array<std::array<unsigned int, 3>, 6> permutations{
+				std::array<unsigned int, 3>{0,1,2}, std::array<unsigned int, 3>{0,2,1},
+				std::array<unsigned int, 3>{1,0,2}, std::array<unsigned int, 3>{1,2,0},
+				std::array<unsigned int, 3>{2,0,1}, std::array<unsigned int, 3>{2,1,0}
+			};
+			std::array<Symmetry, 48> symmetries{};
+			for (std::size_t p{}; p < 6; p++)
+			{
+				for (std::size_t m{}; m < 8; m++)
+				{
+					symmetries[p * 8 + m] = makeSymmetry(permutations[p], m);
+				}
+			}
+			return symmetries;
+		}
+
+	}
+
+	// the full octahedral group (the first element is the identity)
+	constexpr std::array<Symmetry, 48> symmetries{ internal::makeSymmetries() };
+
+	// e.g. "(-y, x, z)"
+	std::string name(const Symmetry& _symmetry);
+
+	template<typename TValue>
+	void apply(std::span<HexVertData<Vec3<TValue>>> _hexes, const Symmetry& _symmetry, TValue _size);
+
+	using HexHasher = hexUtils::VertsHasher;
+
+	// lexicographically smallest corner ordering among the 48 relabelings of the same hex
+	HexVertsU canonical(const HexVertsU& _hex);
+
+	// indices (ascending) of the hexes whose canonical form already occurs earlier in _hexes
+	std::vector<std::size_t> duplicates(const std::vector<HexVertsU>& _hexes);
+
+}
+
+#define RSE_SYMMETRY_TPP
+#include <RSE/symmetry.tpp>
+#undef RSE_SYMMETRY_TPP
\ No newline at end of file
@@ -0,0 +1,24 @@
+#ifndef RSE_SYMMETRY_TPP
+#error __FILE__ cannot be included directly
+#endif
+
+#include <RSE/symmetry.hpp>
+
+#include <RSE/hexUtils.hpp>
+
+namespace RSE::symmetry
+{
+
+	template<typename TValue>
+	void apply(std::span<HexVertData<Vec3<TValue>>> _hexes, const Symmetry& _symmetry, TValue _size)
+	{
+		Vec3<TValue> scales, offsets;
+		for (unsigned int d{}; d < 3; d++)
+		{
+			scales[d] = static_cast<TValue>(_symmetry.mirrored[d] ? -1 : 1);
+			offsets[d] = _symmetry.mirrored[d] ? _size : TValue{ 0 };
+		}
+		hexUtils::mapVerts(_hexes, _symmetry.inds, _symmetry.axes, scales, offsets);
+	}
+
+}
\ No newline at end of file
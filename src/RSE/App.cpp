@@ -4,11 +4,72 @@
 #include <cinolib/gl/gl_glfw.h>
 #include <type_traits>
 #include <string>
+#include <optional>
+#include <array>
+#include <stdexcept>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <numbers>
+#include <thread>
 #include <RSE/hexUtils.hpp>
 
 namespace RSE
 {
 
+	namespace
+	{
+
+		// positions, attributes and adjacency lists; the GL draw lists are not counted
+		std::size_t meshBytes(const cinolib::DrawableHexmesh<>& _mesh)
+		{
+			const auto list{ [](const std::vector<unsigned int>& _list) {
+				return sizeof(_list) + _list.capacity() * sizeof(unsigned int);
+			} };
+			std::size_t bytes{ sizeof(_mesh) };
+			for (unsigned int v{}; v < _mesh.num_verts(); v++)
+			{
+				bytes += sizeof(_mesh.vert(v)) + sizeof(_mesh.vert_data(v)) + list(_mesh.adj_v2v(v)) + list(_mesh.adj_v2e(v)) + list(_mesh.adj_v2f(v)) + list(_mesh.adj_v2p(v));
+			}
+			for (unsigned int e{}; e < _mesh.num_edges(); e++)
+			{
+				bytes += 2 * sizeof(unsigned int) + sizeof(_mesh.edge_data(e)) + list(_mesh.adj_e2f(e)) + list(_mesh.adj_e2p(e));
+			}
+			for (unsigned int f{}; f < _mesh.num_faces(); f++)
+			{
+				bytes += list(_mesh.face_verts_id(f)) + sizeof(_mesh.face_data(f)) + list(_mesh.adj_f2e(f)) + list(_mesh.adj_f2f(f)) + list(_mesh.adj_f2p(f));
+			}
+			for (unsigned int p{}; p < _mesh.num_polys(); p++)
+			{
+				bytes += list(_mesh.adj_p2f(p)) + sizeof(_mesh.poly_data(p)) + list(_mesh.adj_p2e(p)) + list(_mesh.adj_p2p(p));
+			}
+			return bytes;
+		}
+
+		// true if _b has the corners of _a in reverse order, i.e. the two faces lie back to back
+		bool backToBack(const QuadVertsU& _a, const QuadVertsU& _b)
+		{
+			const auto it{ std::find(_b.begin(), _b.end(), _a[0]) };
+			if (it == _b.end())
+			{
+				return false;
+			}
+			const std::size_t first{ static_cast<std::size_t>(it - _b.begin()) };
+			for (std::size_t i{ 1 }; i < 4; i++)
+			{
+				if (_b[(first + 4 - i) % 4] != _a[i])
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+	}
+
 	void App::onGridUpdate()
 	{
 		const Int size{ m_appWidget.source().size() };
@@ -31,9 +92,11 @@ namespace RSE
 		m_borderMesh.push_seg(bords[4], bords[6]);
 		m_borderMesh.push_seg(bords[5], bords[7]);
 		m_borderMesh.update_bbox();
+		m_gridOverlay.make(m_grid);
+		// the grid does not affect culling, so neighbors need no update
 		for (std::size_t i{}; i < m_appWidget.children().size(); i++)
 		{
-			onChildUpdate(i);
+			updateChildMesh(i);
 		}
 		m_mouseGridIndex = 0;
 		m_canvas.marker_sets[c_selectionMarkerSetInd][c_mouseMarkerInd].enabled = false;
@@ -41,7 +104,6 @@ namespace RSE
 
 	void App::onGridCursorUpdate()
 	{
-		m_gridMesh.clear();
 		const IVec3& min{ m_appWidget.source().cursorMin() };
 		const IVec3& max{ m_appWidget.source().cursorMax() };
 		const IVec3 mouse{ m_grid.coord(m_mouseGridIndex) };
@@ -51,65 +113,217 @@ namespace RSE
 			m_mouseGridIndex = m_grid.index(min);
 			m_canvas.marker_sets[c_selectionMarkerSetInd][c_mouseMarkerInd].enabled = false;
 		}
-		if (!m_appWidget.source().hideCursor())
+		m_gridOverlay.visible = !m_appWidget.source().hideCursor();
+		m_gridOverlay.setCursor(min, max);
+	}
+
+	bool App::drawable(std::size_t _child) const
+	{
+		const ChildControl& child{ m_appWidget.children()[_child] };
+		return child.hexControl().valid() && m_appWidget.source().displ().valid() && m_appWidget.shown(child);
+	}
+
+	std::uint8_t App::culledFaces(std::size_t _child) const
+	{
+		if (!m_appWidget.solidMode() || !drawable(_child))
 		{
-			const Int layers{ m_appWidget.source().size() + 1 };
-			m_gridMesh.reserve(static_cast<std::size_t>(layers * layers * 3 * 2 + 8));
-			for (unsigned int d{}; d < 3; d++)
+			return 0;
+		}
+		const FaceIndex& faceIndex{ m_appWidget.faceIndex() };
+		const HexVertsU& verts{ m_appWidget.children()[_child].hexControl().verts() };
+		std::uint8_t faces{};
+		for (std::size_t f{}; f < 6; f++)
+		{
+			const QuadVertsU face{ hexUtils::faceVerts(verts, f) };
+			for (const FaceIndex::FaceRef& ref : faceIndex.refs(face))
 			{
-				IVec3 coord;
-				const unsigned int ds[3]{ d, (d + 1) % 3, (d + 2) % 3 };
-				for (Int x{ min[ds[0]] }; x <= max[ds[0]]; x++)
+				const std::size_t other{ faceIndex.index(ref.hex) };
+				// a duplicate child lying on the same side does not hide the face
+				if (other != _child && drawable(other) && backToBack(face, hexUtils::faceVerts(faceIndex.hex(other), ref.face)))
 				{
-					coord[ds[0]] = x;
-					for (Int y{ min[ds[1]] }; y <= max[ds[1]]; y++)
-					{
-						coord[ds[1]] = y;
-						for (Int z{}; z < 2; z++)
-						{
-							coord[ds[2]] = z ? max[ds[2]] : min[ds[2]];
-							m_gridMesh.push_back(m_grid.point(coord));
-						}
-					}
+					faces |= static_cast<std::uint8_t>(1u << f);
+					break;
 				}
 			}
-			m_gridMesh.update_bbox();
+		}
+		return faces;
+	}
+
+	void App::onChildAdjacencyUpdate(std::size_t _child)
+	{
+		if (culledFaces(_child) != m_childCulledFaces[_child])
+		{
+			onChildUpdate(_child);
 		}
 	}
 
 	void App::onChildUpdate(std::size_t _child)
+	{
+		updateChildMesh(_child);
+		if (!m_appWidget.solidMode())
+		{
+			return;
+		}
+		// neighbors covered by this child in solid mode
+		const FaceIndex& faceIndex{ m_appWidget.faceIndex() };
+		const HexVertsU& verts{ m_appWidget.children()[_child].hexControl().verts() };
+		for (std::size_t f{}; f < 6; f++)
+		{
+			for (const FaceIndex::FaceRef& ref : faceIndex.refs(hexUtils::faceVerts(verts, f)))
+			{
+				const std::size_t other{ faceIndex.index(ref.hex) };
+				if (other != _child)
+				{
+					onChildAdjacencyUpdate(other);
+				}
+			}
+		}
+	}
+
+	void App::onChildrenUpdate(const std::vector<std::size_t>& _children)
+	{
+		// neighbors are notified by the model
+		for (const std::size_t child : _children)
+		{
+			updateChildMesh(child);
+		}
+	}
+
+	void App::updateChildMesh(std::size_t _child)
 	{
 		const ChildControl& child{ m_appWidget.children()[_child] };
-		const bool valid{ child.hexControl().valid() && m_appWidget.source().displ().valid() };
-		const bool shown{ m_appWidget.shown(child) };
-		const HexVerts verts{ m_grid.points(child.hexControl().verts()) };
-		cinolib::DrawableHexmesh<>& mesh{ *m_childMeshes[_child] };
-		if (valid && shown)
+		HexDrawable& mesh{ *m_childMeshes[_child] };
+		if (!m_appWidget.shown(child))
 		{
-			for (std::size_t i{}; i < 8; i++)
+			// hidden children are evaluated when they are shown again
+			if (!m_childDirty[_child])
 			{
-				mesh.vert(static_cast<unsigned int>(i)) = verts[i];
+				m_childDirty[_child] = true;
+				m_childCulledFaces[_child] = 0;
+				mesh.visible = false;
+				m_childMarkers[_child] = 0;
+				m_vertMarkersDirty = true;
 			}
-			mesh.poly_set_color(child.style().color(1.0f, 1.0f, m_appWidget.solidMode() ? 1.0f : 0.75f));
-			mesh.show_in_wireframe(m_appWidget.solidMode());
-			mesh.show_out_wireframe(m_appWidget.solidMode());
-			mesh.update_normals();
-			mesh.updateGL();
-			mesh.update_normals();
-			mesh.updateGL();
+			return;
 		}
-		mesh.show_mesh(valid && shown);
-		mesh.update_bbox();
+		m_childDirty[_child] = false;
+		const bool valid{ child.hexControl().valid() && m_appWidget.source().displ().valid() };
+		const std::uint8_t culledFaces{ this->culledFaces(_child) };
+		m_childCulledFaces[_child] = culledFaces;
+		mesh.setVerts(m_grid.points(child.hexControl().verts()));
+		mesh.setColor(child.style().color(1.0f, 1.0f, m_appWidget.solidMode() ? 1.0f : 0.75f));
+		mesh.setCulledFaces(culledFaces);
+		mesh.wireframe = m_appWidget.solidMode();
+		mesh.visible = valid;
 		const HexVertData<std::size_t> firstOccurrencies{ child.hexControl().firstOccurrenceIndices() };
+		std::uint8_t markers{};
 		for (std::size_t i{}; i < 8; i++)
 		{
-			cinolib::Marker& marker{ m_canvas.marker_sets[c_vertsMarkerSetInd][i + _child * 8] };
-			const bool duplicate{ firstOccurrencies[i] != i };
-			marker.pos_3d = verts[i];
-			marker.color = duplicate ? cinolib::Color::YELLOW() : child.style().color(0.25f);
-			marker.font_size = child.active() ? 18u : 0u;
-			marker.enabled = shown && (child.active() || duplicate);
-			marker.shape = !child.active() && duplicate ? cinolib::Marker::EShape::Cross90 : cinolib::Marker::EShape::CircleFilled;
+			if (child.active() || firstOccurrencies[i] != i)
+			{
+				markers |= static_cast<std::uint8_t>(1u << i);
+			}
+		}
+		m_childMarkers[_child] = markers;
+		m_vertMarkersDirty = true;
+	}
+
+	const HexVertData<std::string> App::c_vertLabels{ "0", "1", "2", "3", "4", "5", "6", "7" };
+
+	void App::updateVertMarkers()
+	{
+		std::vector<cinolib::Marker>& markers{ m_canvas.marker_sets[c_vertsMarkerSetInd] };
+		markers.clear();
+		const std::optional<std::size_t> activeChild{ m_appWidget.activeChildIndex() };
+		for (std::size_t c{}; c < m_childMarkers.size(); c++)
+		{
+			if (!m_childMarkers[c])
+			{
+				continue;
+			}
+			const ChildControl& child{ m_appWidget.children()[c] };
+			const bool active{ activeChild == c };
+			const HexVerts verts{ m_grid.points(child.hexControl().verts()) };
+			const HexVertData<std::size_t> firstOccurrencies{ child.hexControl().firstOccurrenceIndices() };
+			for (std::size_t i{}; i < 8; i++)
+			{
+				if (m_childMarkers[c] & (1u << i))
+				{
+					const bool duplicate{ firstOccurrencies[i] != i };
+					cinolib::Marker& out{ markers.emplace_back() };
+					out.pos_3d = verts[i];
+					out.color = duplicate ? cinolib::Color::YELLOW() : child.style().color(0.25f);
+					out.shape = !child.active() && duplicate ? cinolib::Marker::EShape::Cross90 : cinolib::Marker::EShape::CircleFilled;
+					out.shape_radius = 4u;
+					out.enabled = true;
+					if (active)
+					{
+						out.text = c_vertLabels[i];
+						out.font_size = 18u;
+					}
+					else
+					{
+						out.font_size = 0u;
+					}
+				}
+			}
+		}
+		m_vertMarkersDirty = false;
+	}
+
+	void App::onUpdate()
+	{
+		m_appWidget.update();
+		if (m_vertMarkersDirty)
+		{
+			updateVertMarkers();
+			glfwPostEmptyEvent();
+		}
+	}
+
+	void App::recordInput(const InputLog::Event& _event)
+	{
+		if (m_inputLog)
+		{
+			InputLog::Event& event{ m_inputLog->events.emplace_back(_event) };
+			event.microseconds = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_inputLogStart).count();
+		}
+	}
+
+	void App::onModelEvent(InputLog::EModelEvent _event)
+	{
+		m_modelEventCount++;
+		if (m_replayedModelEvents)
+		{
+			m_replayedModelEvents->push_back(_event);
+		}
+		recordInput({ .type = InputLog::EType::Model, .key = static_cast<int>(_event) });
+	}
+
+	void App::onPreviewUpdate()
+	{
+		if (m_previewMesh)
+		{
+			m_canvas.pop(m_previewMesh);
+			delete m_previewMesh;
+			m_previewMesh = nullptr;
+		}
+		if (m_previewWidget.mesh())
+		{
+			const Refiner::Mesh& refined{ *m_previewWidget.mesh() };
+			std::vector<std::vector<unsigned int>> polys(refined.hexes.size(), std::vector<unsigned int>(8));
+			for (std::size_t p{}; p < refined.hexes.size(); p++)
+			{
+				for (std::size_t i{}; i < 8; i++)
+				{
+					polys[p][i] = static_cast<unsigned int>(refined.hexes[p][vertsOrder[i]]);
+				}
+			}
+			m_previewMesh = new cinolib::DrawableHexmesh<>{ refined.verts, polys };
+			m_previewMesh->poly_set_color(cinolib::Color::hsv2rgb(0.6f, 0.3f, 0.9f));
+			m_previewMesh->show_mesh_flat();
+			m_previewMesh->updateGL();
+			m_canvas.push(m_previewMesh, false);
 		}
 	}
 
@@ -117,38 +331,86 @@ namespace RSE
 
 	void App::onChildAdd()
 	{
-		cinolib::DrawableHexmesh<>& mesh{ *new cinolib::DrawableHexmesh<>{} };
-		mesh.poly_set_color(cinolib::Color::BLACK());
-		mesh.show_in_wireframe_width(2);
-		mesh.show_out_wireframe_width(2);
-		mesh.show_mesh_flat();
-		mesh.draw_back_faces = false;
-		for (const RVec3& vert : cubeVerts)
+		addChildMesh();
+		onChildUpdate(m_childMeshes.size() - 1);
+	}
+
+	void App::addChildMesh()
+	{
+		// no connectivity to build: the topology is shared by every child
+		HexDrawable& mesh{ *new HexDrawable{} };
+		mesh.setVerts(cubeVerts);
+		m_childMeshes.push_back(&mesh);
+		m_childMarkers.push_back(0);
+		m_childCulledFaces.push_back(0);
+		m_childDirty.push_back(false);
+	}
+
+	bool App::deferred(bool& _flag)
+	{
+		_flag |= m_appWidget.batching();
+		return m_appWidget.batching();
+	}
+
+	bool App::deferredChild(std::size_t _child)
+	{
+		if (m_appWidget.batching())
 		{
-			mesh.vert_add(vert);
+			m_batchChildren.push_back(_child);
 		}
-		mesh.poly_add(vertsOrder);
-		m_childMeshes.push_back(&mesh);
-		m_canvas.marker_sets[c_vertsMarkerSetInd].resize(m_childMeshes.size() * 8);
-		for (std::size_t i{}; i < 8; i++)
+		return m_appWidget.batching();
+	}
+
+	void App::onBatchEnd()
+	{
+		if (m_batchRebuild)
 		{
-			const std::size_t mi{ i + (m_childMeshes.size() - 1) * 8 };
-			m_canvas.marker_sets[c_vertsMarkerSetInd][mi] = {
-				.text{std::to_string(i)},
-				.shape_radius = 4u,
-				.enabled = false,
-			};
+			// the children were removed or the source changed
+			onChildrenClear();
+			m_childMeshes.reserve(m_appWidget.children().size());
+			for (std::size_t i{}; i < m_appWidget.children().size(); i++)
+			{
+				addChildMesh();
+			}
+			m_grid.setPrecision(m_appWidget.precision());
+			onGridUpdate();
+			onGridCursorUpdate();
+			onActiveVertChange();
 		}
-		m_canvas.push(m_childMeshes.back(), false);
-		onChildUpdate(m_childMeshes.size() - 1);
+		else
+		{
+			// children are only appended inside a batch that needs no rebuild
+			while (m_childMeshes.size() < m_appWidget.children().size())
+			{
+				addChildMesh();
+			}
+			std::sort(m_batchChildren.begin(), m_batchChildren.end());
+			m_batchChildren.erase(std::unique(m_batchChildren.begin(), m_batchChildren.end()), m_batchChildren.end());
+			for (const std::size_t child : m_batchChildren)
+			{
+				onChildUpdate(child);
+			}
+			if (m_batchCursor)
+			{
+				onGridCursorUpdate();
+			}
+			if (m_batchActiveVert)
+			{
+				onActiveVertChange();
+			}
+		}
+		m_batchRebuild = m_batchCursor = m_batchActiveVert = false;
+		m_batchChildren.clear();
 	}
 
 	void App::onChildrenClear()
 	{
-		m_canvas.marker_sets[c_vertsMarkerSetInd].clear();
-		for (cinolib::DrawableHexmesh<>* mesh : m_childMeshes)
+		m_childMarkers.clear();
+		m_childCulledFaces.clear();
+		m_childDirty.clear();
+		m_vertMarkersDirty = true;
+		for (HexDrawable* mesh : m_childMeshes)
 		{
-			m_canvas.pop(mesh);
 			delete mesh;
 		}
 		m_childMeshes.clear();
@@ -156,9 +418,10 @@ namespace RSE
 
 	void App::onChildRemove(std::size_t _child)
 	{
-		m_canvas.pop(m_childMeshes[_child]);
-		const auto begin{ m_canvas.marker_sets[c_vertsMarkerSetInd].begin() + _child * 8 };
-		m_canvas.marker_sets[c_vertsMarkerSetInd].erase(begin, begin + 8);
+		m_childMarkers.erase(m_childMarkers.begin() + _child);
+		m_childCulledFaces.erase(m_childCulledFaces.begin() + _child);
+		m_childDirty.erase(m_childDirty.begin() + _child);
+		m_vertMarkersDirty = true;
 		delete m_childMeshes[_child];
 		m_childMeshes.erase(m_childMeshes.begin() + _child);
 	}
@@ -241,9 +504,16 @@ namespace RSE
 	void App::onMouseMove()
 	{
 		const cinolib::Ray r{ m_canvas.eye_to_mouse_ray() };
+		onMouseRay(r.begin(), r.dir());
+	}
+
+	void App::onMouseRay(const RVec3& _origin, const RVec3& _dir)
+	{
+		// the ray, not the cursor position, is logged so that replays do not depend on the camera
+		recordInput({ .type = InputLog::EType::MouseRay, .origin = _origin, .dir = _dir });
 		const IVec3 min{ m_appWidget.source().cursorMin() };
 		const IVec3 max{ m_appWidget.source().cursorMax() };
-		m_mouseGridIndex = m_grid.closestToRay(r.begin(), r.dir(), min, max);
+		m_mouseGridIndex = m_grid.closestToRay(_origin, _dir, min, max);
 		cinolib::Marker& marker{ m_canvas.marker_sets[c_selectionMarkerSetInd][c_mouseMarkerInd] };
 		marker.pos_3d = m_grid.point(m_mouseGridIndex);
 		marker.enabled = true;
@@ -251,6 +521,11 @@ namespace RSE
 
 	bool App::onKeyPress(int _key, int _modifiers)
 	{
+		recordInput({ .type = InputLog::EType::Key, .key = _key, .modifiers = _modifiers });
+		if (m_appWidget.loading())
+		{
+			return false;
+		}
 		const cinolib::KeyBinding binding{ _key, _modifiers };
 		if (binding == c_kbAddChild)
 		{
@@ -427,6 +702,11 @@ namespace RSE
 
 	bool App::onClick(int _modifiers)
 	{
+		recordInput({ .type = InputLog::EType::Click, .modifiers = _modifiers });
+		if (m_appWidget.loading())
+		{
+			return false;
+		}
 		const auto pickActive{ [this](std::size_t _child) {
 			const HexVertsU& verts{ m_appWidget.children()[_child].hexControl().verts() };
 			const auto it{ std::find(verts.begin(), verts.end(), m_grid.coord(m_mouseGridIndex)) };
@@ -547,7 +827,7 @@ namespace RSE
 		std::cout << "-------------------------------" << std::endl;
 	}
 
-	App::App() : m_canvas{ 700, 600, 13, 1.0f }, m_axesWidget{ m_canvas.camera }, m_appWidget{}, m_grid{}, m_gridMesh{}, m_borderMesh{}, m_mouseGridIndex{}, vertsOrder{}
+	App::App() : m_canvas{ 700, 600, 13, 1.0f }, m_axesWidget{ m_canvas.camera }, m_updateWidget{}, m_appWidget{}, m_previewWidget{ m_appWidget }, m_libraryWidget{ m_appWidget }, m_consoleWidget{ m_appWidget }, m_memoryWidget{}, m_previewMesh{}, m_grid{}, m_gridOverlay{}, m_borderMesh{}, m_mouseGridIndex{}, vertsOrder{}, m_childMarkers{}, m_childCulledFaces{}, m_childDirty{}
 	{
 		// vertsOrder
 		vertsOrder.resize(8);
@@ -561,19 +841,49 @@ namespace RSE
 		m_borderMesh.set_thickness(1);
 		m_borderMesh.reserve(12 * 2);
 		// grid
-		m_gridMesh.set_color(cinolib::Color::WHITE());
-		m_gridMesh.set_cheap_rendering(true);
-		m_gridMesh.set_thickness(1);
+		m_gridOverlay.color = cinolib::Color::WHITE();
+		m_gridOverlay.thickness = 1.0f;
 		// app widget
 		m_appWidget.show_open = true;
-		m_appWidget.onSourceUpdate += [this]() { onGridUpdate(); };
-		m_appWidget.onCursorUpdate += [this]() { onGridCursorUpdate(); };
-		m_appWidget.onChildAdd += [this]() { onChildAdd(); };
-		m_appWidget.onChildrenClear += [this]() { onChildrenClear(); };
-		m_appWidget.onActiveVertChange += [this]() { onActiveVertChange(); };
-		m_appWidget.onChildRemove += [this](std::size_t _i) { onChildRemove(_i); };
-		m_appWidget.onChildUpdate += [this](std::size_t _i) { onChildUpdate(_i); };
+		// inside a batch only the touched children are updated on onBatchEnd, unless the batch removes children or changes the source
+		m_appWidget.onSourceUpdate += [this]() { if (!deferred(m_batchRebuild)) { onGridUpdate(); } };
+		m_appWidget.onCursorUpdate += [this]() { if (!deferred(m_batchCursor)) { onGridCursorUpdate(); } };
+		m_appWidget.onChildAdd += [this]() { if (!deferredChild(m_appWidget.children().size() - 1)) { onChildAdd(); } };
+		m_appWidget.onChildrenClear += [this]() { if (!deferred(m_batchRebuild)) { onChildrenClear(); } };
+		m_appWidget.onActiveVertChange += [this]() { if (!deferred(m_batchActiveVert)) { onActiveVertChange(); } };
+		m_appWidget.onChildRemove += [this](std::size_t _i) { if (!deferred(m_batchRebuild)) { onChildRemove(_i); } };
+		m_appWidget.onChildUpdate += [this](std::size_t _i) { if (!deferredChild(_i)) { onChildUpdate(_i); } };
+		m_appWidget.onChildViewUpdate += [this](std::size_t _i) { if (!deferredChild(_i)) { onChildUpdate(_i); } };
+		m_appWidget.onChildAdjacencyUpdate += [this](std::size_t _i) { if (!deferredChild(_i)) { onChildAdjacencyUpdate(_i); } };
+		m_appWidget.onChildrenUpdate += [this](const std::vector<std::size_t>& _children) {
+			if (m_appWidget.batching())
+			{
+				m_batchChildren.insert(m_batchChildren.end(), _children.begin(), _children.end());
+			}
+			else
+			{
+				onChildrenUpdate(_children);
+			}
+		};
 		m_appWidget.onFileChange += [this]() { setWindowTitle(); };
+		m_appWidget.onPrecisionChange += [this]() { if (!deferred(m_batchRebuild)) { m_grid.setPrecision(m_appWidget.precision()); onGridUpdate(); onGridCursorUpdate(); } };
+		m_appWidget.onBatchEnd += [this]() { onBatchEnd(); };
+		m_appWidget.onSourceUpdate += [this]() { onModelEvent(InputLog::EModelEvent::SourceUpdate); };
+		m_appWidget.onCursorUpdate += [this]() { onModelEvent(InputLog::EModelEvent::CursorUpdate); };
+		m_appWidget.onChildrenClear += [this]() { onModelEvent(InputLog::EModelEvent::ChildrenClear); };
+		m_appWidget.onChildAdd += [this]() { onModelEvent(InputLog::EModelEvent::ChildAdd); };
+		m_appWidget.onChildRemove += [this](std::size_t) { onModelEvent(InputLog::EModelEvent::ChildRemove); };
+		m_appWidget.onChildUpdate += [this](std::size_t) { onModelEvent(InputLog::EModelEvent::ChildUpdate); };
+		m_appWidget.onChildrenUpdate += [this](const std::vector<std::size_t>&) { onModelEvent(InputLog::EModelEvent::ChildrenUpdate); };
+		// preview widget
+		m_previewWidget.onMeshUpdate += [this]() { onPreviewUpdate(); };
+		// update widget
+		m_updateWidget.onUpdate += [this]() { onUpdate(); };
+		// memory widget
+		m_memoryWidget.onReport += [this](MemoryReport& _report) { memoryReport(_report); };
+		// console widget
+		m_consoleWidget.onRun += [this](const std::string& _line) { recordInput({ .type = InputLog::EType::Command, .text = _line }); };
+		m_consoleWidget.onRunFile += [this](const std::string& _filename) { recordInput({ .type = InputLog::EType::Script, .text = _filename }); };
 		// markers
 		m_canvas.marker_sets.resize(2, {});
 		m_canvas.marker_sets[c_selectionMarkerSetInd].resize(2);
@@ -597,9 +907,15 @@ namespace RSE
 		// canvas
 		m_canvas.background = cinolib::Color::hsv2rgb(0.0f, 0.0f, 0.1f);
 		m_canvas.push(&m_axesWidget);
+		m_canvas.push(&m_updateWidget);
 		m_canvas.push(&m_appWidget);
+		m_canvas.push(&m_previewWidget);
+		m_canvas.push(&m_libraryWidget);
+		m_canvas.push(&m_consoleWidget);
+		m_canvas.push(&m_memoryWidget);
 		m_canvas.push(&m_borderMesh);
-		m_canvas.push(&m_gridMesh);
+		m_canvas.push(&m_gridOverlay);
+		m_canvas.push(&m_childBatch, false);
 		m_canvas.depth_cull_markers = false;
 		m_canvas.show_sidebar(true);
 		m_canvas.key_bindings.pan_with_arrow_keys = false;
@@ -614,10 +930,303 @@ namespace RSE
 		m_appWidget.load(_file);
 	}
 
+	void App::loadSync(const std::string& _file)
+	{
+		m_appWidget.load(_file);
+		while (m_appWidget.loading())
+		{
+			m_appWidget.update();
+			std::this_thread::yield();
+		}
+	}
+
+	void App::memoryReport(MemoryReport& _report) const
+	{
+		m_appWidget.memoryReport(_report);
+		_report.add("Child meshes", m_childMeshes.size(), MemoryReport::bytes(m_childMeshes) + m_childMeshes.size() * sizeof(HexDrawable));
+		_report.add("Child view state", m_childMarkers.size(), MemoryReport::bytes(m_childMarkers) + MemoryReport::bytes(m_childCulledFaces) + MemoryReport::bytes(m_childDirty));
+		const std::vector<cinolib::Marker>& markers{ m_canvas.marker_sets[c_vertsMarkerSetInd] };
+		_report.add("Vertex markers", markers.size(), MemoryReport::bytes(markers));
+		_report.add("Grid", 1, m_grid.bytes() + m_gridOverlay.bytes());
+		if (m_previewMesh)
+		{
+			_report.add("Preview mesh", 1, meshBytes(*m_previewMesh));
+		}
+	}
+
+	// an owned framebuffer object to render into, since the default framebuffer of a hidden window has undefined contents;
+	// the entry points are core since OpenGL 3.0 but missing from the 1.x headers, so they are loaded through GLFW
+	class OffscreenTarget final
+	{
+
+	private:
+
+		static constexpr GLenum c_framebuffer{ 0x8D40 }, c_renderbuffer{ 0x8D41 }, c_complete{ 0x8CD5 };
+		static constexpr GLenum c_colorAttachment{ 0x8CE0 }, c_depthAttachment{ 0x8D00 }, c_rgba8{ 0x8058 }, c_depth24{ 0x81A6 };
+
+		using GenFunc = void(*)(GLsizei, GLuint*);
+		using DeleteFunc = void(*)(GLsizei, const GLuint*);
+		using BindFunc = void(*)(GLenum, GLuint);
+		using StorageFunc = void(*)(GLenum, GLenum, GLsizei, GLsizei);
+		using AttachFunc = void(*)(GLenum, GLenum, GLenum, GLuint);
+		using StatusFunc = GLenum(*)(GLenum);
+
+		template<typename TFunc>
+		static TFunc load(const char* _name)
+		{
+			const GLFWglproc proc{ glfwGetProcAddress(_name) };
+			if (!proc)
+			{
+				throw std::runtime_error{ "framebuffer objects are not supported (missing " + std::string{ _name } + ")" };
+			}
+			return reinterpret_cast<TFunc>(proc);
+		}
+
+		const BindFunc m_bindFramebuffer{ load<BindFunc>("glBindFramebuffer") };
+		const DeleteFunc m_deleteFramebuffers{ load<DeleteFunc>("glDeleteFramebuffers") };
+		const DeleteFunc m_deleteRenderbuffers{ load<DeleteFunc>("glDeleteRenderbuffers") };
+		GLuint m_framebuffer{};
+		std::array<GLuint, 2> m_renderbuffers{};
+
+		void release()
+		{
+			m_bindFramebuffer(c_framebuffer, 0);
+			m_deleteRenderbuffers(2, m_renderbuffers.data());
+			m_deleteFramebuffers(1, &m_framebuffer);
+		}
+
+	public:
+
+		OffscreenTarget(int _width, int _height)
+		{
+			const auto genFramebuffers{ load<GenFunc>("glGenFramebuffers") };
+			const auto genRenderbuffers{ load<GenFunc>("glGenRenderbuffers") };
+			const auto bindRenderbuffer{ load<BindFunc>("glBindRenderbuffer") };
+			const auto renderbufferStorage{ load<StorageFunc>("glRenderbufferStorage") };
+			const auto framebufferRenderbuffer{ load<AttachFunc>("glFramebufferRenderbuffer") };
+			const auto checkFramebufferStatus{ load<StatusFunc>("glCheckFramebufferStatus") };
+			genFramebuffers(1, &m_framebuffer);
+			genRenderbuffers(2, m_renderbuffers.data());
+			m_bindFramebuffer(c_framebuffer, m_framebuffer);
+			const std::array<std::array<GLenum, 2>, 2> formats{ std::array<GLenum, 2>{ c_rgba8, c_colorAttachment }, std::array<GLenum, 2>{ c_depth24, c_depthAttachment } };
+			for (std::size_t i{}; i < 2; i++)
+			{
+				bindRenderbuffer(c_renderbuffer, m_renderbuffers[i]);
+				renderbufferStorage(c_renderbuffer, formats[i][0], _width, _height);
+				framebufferRenderbuffer(c_framebuffer, formats[i][1], c_renderbuffer, m_renderbuffers[i]);
+			}
+			bindRenderbuffer(c_renderbuffer, 0);
+			if (checkFramebufferStatus(c_framebuffer) != c_complete)
+			{
+				release();
+				throw std::runtime_error{ "incomplete offscreen framebuffer" };
+			}
+		}
+
+		OffscreenTarget(const OffscreenTarget&) = delete;
+
+		OffscreenTarget& operator=(const OffscreenTarget&) = delete;
+
+		~OffscreenTarget()
+		{
+			release();
+		}
+
+	};
+
+	App::RenderStats App::render(const std::string& _file, std::size_t _frames, const std::optional<std::string>& _imagePrefix)
+	{
+		glfwHideWindow(m_canvas.window);
+		m_canvas.show_sidebar(false);
+		loadSync(_file);
+		const Int size{ m_appWidget.source().size() };
+		const RVec3 min{ m_grid.point(IVec3{ 0,0,0 }) }, max{ m_grid.point(IVec3{ size, size, size }) };
+		const RVec3 center{ (min + max) / 2 };
+		const Real distance{ min.dist(max) * 1.5 };
+		int width{}, height{};
+		glfwGetFramebufferSize(m_canvas.window, &width, &height);
+		std::vector<unsigned char> pixels(static_cast<std::size_t>(width * height * 3));
+		// GLcanvas::draw swaps the buffers itself; without vsync the swap does not block and stays out of the frame time
+		glfwSwapInterval(0);
+		const OffscreenTarget target{ width, height };
+		RenderStats stats{};
+		stats.frameSeconds.reserve(_frames);
+		stats.frameHashes.reserve(_frames);
+		for (std::size_t f{}; f < _frames; f++)
+		{
+			// orbit around the vertical axis
+			const Real angle{ 2 * std::numbers::pi * static_cast<Real>(f) / static_cast<Real>(std::max<std::size_t>(_frames, 1)) };
+			const RVec3 eye{ center + RVec3{ std::cos(angle), 0.5, std::sin(angle) } * distance };
+			m_canvas.camera.view.eye = eye;
+			m_canvas.camera.view.forward = (center - eye).normalized();
+			m_canvas.camera.view.up = cinolib::GLcanvas::world_up();
+			onUpdate();
+			const auto start{ std::chrono::steady_clock::now() };
+			m_canvas.draw();
+			glFinish();
+			stats.frameSeconds.push_back(std::chrono::duration<Real>{ std::chrono::steady_clock::now() - start }.count());
+			glPixelStorei(GL_PACK_ALIGNMENT, 1);
+			glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+			// FNV-1a
+			std::uint64_t hash{ 14695981039346656037ull };
+			for (const unsigned char byte : pixels)
+			{
+				hash = (hash ^ byte) * 1099511628211ull;
+			}
+			stats.frameHashes.push_back(hash);
+			if (_imagePrefix)
+			{
+				std::ofstream image{ *_imagePrefix + std::to_string(f) + ".ppm", std::ios::binary };
+				image << "P6\n" << width << ' ' << height << "\n255\n";
+				for (int y{ height - 1 }; y >= 0; y--)
+				{
+					image.write(reinterpret_cast<const char*>(pixels.data() + static_cast<std::size_t>(y * width * 3)), width * 3);
+				}
+			}
+		}
+		return stats;
+	}
+
+	std::ostream& operator<<(std::ostream& _stream, const App::RenderStats& _stats)
+	{
+		std::vector<Real> sorted{ _stats.frameSeconds };
+		std::sort(sorted.begin(), sorted.end());
+		for (std::size_t f{}; f < _stats.frameSeconds.size(); f++)
+		{
+			_stream << "frame " << f << ": " << _stats.frameSeconds[f] * 1000 << "ms " << std::hex << std::setw(16) << std::setfill('0') << _stats.frameHashes[f] << std::dec << std::setfill(' ') << '\n';
+		}
+		if (!sorted.empty())
+		{
+			Real total{};
+			for (const Real seconds : sorted)
+			{
+				total += seconds;
+			}
+			_stream << "frames: " << sorted.size()
+				<< ", mean: " << total / static_cast<Real>(sorted.size()) * 1000 << "ms"
+				<< ", min: " << sorted.front() * 1000 << "ms"
+				<< ", p95: " << sorted[sorted.size() * 95 / 100] * 1000 << "ms"
+				<< ", max: " << sorted.back() * 1000 << "ms";
+		}
+		return _stream;
+	}
+
 	int App::launch()
 	{
 		printBindings();
 		return m_canvas.launch();
 	}
 
+	int App::record(InputLog& _log)
+	{
+		// the load is not part of the session, as replay loads the file before the first event
+		if (_log.file)
+		{
+			loadSync(*_log.file);
+		}
+		m_inputLog = &_log;
+		m_inputLogStart = std::chrono::steady_clock::now();
+		m_modelEventCount = 0;
+		const int result{ launch() };
+		m_inputLog = nullptr;
+		return result;
+	}
+
+	LatencyReport App::replay(const InputLog& _log, bool _render)
+	{
+		glfwHideWindow(m_canvas.window);
+		m_canvas.show_sidebar(false);
+		LatencyReport report{};
+		m_modelEventCount = 0;
+		if (_log.file)
+		{
+			loadSync(*_log.file);
+		}
+		std::optional<OffscreenTarget> target{};
+		if (_render)
+		{
+			int width{}, height{};
+			glfwGetFramebufferSize(m_canvas.window, &width, &height);
+			glfwSwapInterval(0);
+			target.emplace(width, height);
+		}
+		const auto time{ [&report](const std::string& _handler, const auto& _func) {
+			const auto start{ std::chrono::steady_clock::now() };
+			_func();
+			report.add(_handler, std::chrono::duration<Real>{ std::chrono::steady_clock::now() - start }.count());
+		} };
+		// the model must go through the recorded events in the same order, or the timings are meaningless
+		std::vector<InputLog::EModelEvent> replayed{};
+		std::size_t recorded{};
+		const auto diverged{ [&]() {
+			return std::runtime_error{ "replay diverged from the recording at model event " + std::to_string(recorded) + " (actions that are not logged, such as sidebar edits, cannot be replayed)" };
+		} };
+		m_replayedModelEvents = &replayed;
+		try
+		{
+			for (const InputLog::Event& event : _log.events)
+			{
+				if (event.type == InputLog::EType::Model)
+				{
+					report.recordedModelEvents++;
+					if (recorded >= replayed.size() || replayed[recorded] != static_cast<InputLog::EModelEvent>(event.key))
+					{
+						throw diverged();
+					}
+					recorded++;
+					continue;
+				}
+				if (replayed.size() > recorded)
+				{
+					throw diverged();
+				}
+				switch (event.type)
+				{
+					case InputLog::EType::Key:
+					{
+						// bindings that open file dialogs cannot be replayed
+						const cinolib::KeyBinding binding{ event.key, event.modifiers };
+						if (binding == c_kbSave || binding == c_kbSaveNew || binding == c_kbOpen)
+						{
+							continue;
+						}
+						time("onKeyPress", [&]() { onKeyPress(event.key, event.modifiers); });
+					}
+					break;
+					case InputLog::EType::MouseRay:
+						time("onMouseRay", [&]() { onMouseRay(event.origin, event.dir); });
+						break;
+					case InputLog::EType::Click:
+						time("onClick", [&]() { onClick(event.modifiers); });
+						break;
+					case InputLog::EType::Command:
+						time("command", [&]() { m_consoleWidget.run(event.text); });
+						break;
+					case InputLog::EType::Script:
+						time("script", [&]() { m_consoleWidget.runFile(event.text); });
+						break;
+					case InputLog::EType::Model:
+						break;
+				}
+				time("onUpdate", [&]() { onUpdate(); });
+				if (_render)
+				{
+					time("draw", [&]() { m_canvas.draw(); glFinish(); });
+				}
+			}
+			if (replayed.size() != recorded)
+			{
+				throw diverged();
+			}
+		}
+		catch (...)
+		{
+			m_replayedModelEvents = nullptr;
+			throw;
+		}
+		m_replayedModelEvents = nullptr;
+		report.replayedModelEvents = m_modelEventCount;
+		return report;
+	}
+
 }
\ No newline at end of file
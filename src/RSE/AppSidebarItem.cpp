@@ -4,23 +4,45 @@
 #include <cinolib/gl/file_dialog_save.h>
 #include <cinolib/gl/file_dialog_open.h>
 #include <cinolib/gl/gl_glfw.h>
-#include <cpputils/serialization/Serializer.hpp>
-#include <cpputils/serialization/Deserializer.hpp>
 #include <stdexcept>
+#include <exception>
 #include <imgui.h>
 #include <algorithm>
 #include <fstream>
+#include <filesystem>
+#include <memory>
 #include <cctype>
 #include <string>
 #include <RSE/Style.hpp>
 #include <RSE/CppExporter.hpp>
+#include <RSE/schemeIO.hpp>
 #include <iterator>
+#include <span>
+#include <unordered_set>
 
 namespace RSE
 {
 
-	AppSidebarItem::AppSidebarItem(): cinolib::SideBarItem{ "App" }, m_children{}, m_sourceControl{}, m_activeChild{}, onSourceUpdate{}, m_hasAnySelected{ false }, m_singleMode{ false }, m_file{}, editDim{ hexUtils::EDim::X }
+	AppSidebarItem::AppSidebarItem(): cinolib::SideBarItem{ "App" }, m_children{}, m_sourceControl{}, m_activeChild{}, onSourceUpdate{}, m_hasAnySelected{ false }, m_singleMode{ false }, m_file{}, m_faceIndex{}, m_autosaver{}, m_lastAutosave{ std::chrono::steady_clock::now() }, m_unnamedAutosaveFile{ (std::filesystem::temp_directory_path() / ("unnamed-" + std::to_string(std::chrono::system_clock::now().time_since_epoch().count()) + ".rse.autosave")).string() }, editDim{ hexUtils::EDim::X }
 	{
+		onSourceUpdate += [this]() { m_precisionDeviation = std::nullopt; invalidate(); };
+		onChildrenClear += [this]() { mutableVerts().clear(); m_faceIndex.clear(); invalidate(); };
+		onChildAdd += [this]() { mutableVerts().push_back(m_children.back()->hexControl().verts()); m_faceIndex.add(); invalidate(); };
+		onChildRemove += [this](std::size_t) { invalidate(); };
+		onChildUpdate += [this](std::size_t _i) {
+			const HexVertsU& verts{ m_children[_i]->hexControl().verts() };
+			if ((*m_verts)[_i] != verts)
+			{
+				const HexVertsU oldVerts{ (*m_verts)[_i] };
+				mutableVerts()[_i] = verts;
+				for (const std::size_t neighbor : m_faceIndex.update(_i, oldVerts))
+				{
+					onChildAdjacencyUpdate(neighbor);
+				}
+			}
+			invalidate();
+		};
+		m_faceIndex.rebind(*m_verts);
 	}
 
 	Int AppSidebarItem::minRequiredSize() const
@@ -41,21 +63,125 @@ namespace RSE
 		const std::string filename{ (_new || !m_file) ? cinolib::file_dialog_save() : m_file.value_or("") };
 		if (!filename.empty())
 		{
-			m_file = filename;
-			onFileChange();
-			std::ofstream file{};
-			file.open(filename);
-			cpputils::serialization::Serializer s{ file };
-			s << m_sourceControl.size() << m_children.size();
-			for (const ChildControl* child : m_children)
+			try
 			{
-				for (const IVec3& vert : child->hexControl().verts())
-				{
-					s << vert.x() << vert.y() << vert.z();
-				}
+				saveAs(filename);
+			}
+			catch (const std::exception& _exception)
+			{
+				std::cerr << "Failed to save '" << filename << "': " << _exception.what() << std::endl;
 			}
-			file.close();
-			std::cout << "Saved to '" << filename << "'" << std::endl;
+		}
+	}
+
+	void AppSidebarItem::saveAs(const std::string& _filename)
+	{
+		schemeIO::save(_filename, m_sourceControl.size(), *snapshot());
+		const std::string oldAutosaveFile{ autosaveFile() };
+		m_file = _filename;
+		onFileChange();
+		m_autosaveDirty = false;
+		// the saved file supersedes the recovery files
+		m_autosaver.discard(oldAutosaveFile);
+		if (autosaveFile() != oldAutosaveFile)
+		{
+			m_autosaver.discard(autosaveFile());
+		}
+		std::cout << "Saved to '" << _filename << "'" << std::endl;
+	}
+
+	void AppSidebarItem::beginBatch()
+	{
+		m_batchDepth++;
+	}
+
+	void AppSidebarItem::endBatch()
+	{
+		if (!m_batchDepth)
+		{
+			throw std::logic_error{ "not in a batch" };
+		}
+		if (!--m_batchDepth)
+		{
+			onBatchEnd();
+		}
+	}
+
+	bool AppSidebarItem::batching() const
+	{
+		return m_batchDepth;
+	}
+
+	void AppSidebarItem::invalidate()
+	{
+		m_revision++;
+		m_autosaveDirty = true;
+		m_validation = std::nullopt;
+	}
+
+	std::size_t AppSidebarItem::revision() const
+	{
+		return m_revision;
+	}
+
+	void AppSidebarItem::memoryReport(MemoryReport& _report) const
+	{
+		_report.add("Children", m_children.size(), MemoryReport::bytes(m_children) + m_children.size() * sizeof(ChildControl));
+		_report.add("Face index", m_faceIndex.size(), m_faceIndex.bytes());
+		_report.add("Packed vertices", m_verts->size(), MemoryReport::bytes(*m_verts));
+		if (m_exportCache)
+		{
+			_report.add("Export cache", 1, m_exportCache->code.capacity());
+		}
+		if (m_loadScheme)
+		{
+			_report.add("Loading", m_loadScheme->children.size(), MemoryReport::bytes(m_loadScheme->children));
+		}
+	}
+
+	const SchemeValidator::Report& AppSidebarItem::validate()
+	{
+		if (!m_validation)
+		{
+			m_validation = SchemeValidator{}(m_sourceControl.size(), *snapshot());
+		}
+		return *m_validation;
+	}
+
+	Autosaver::Children AppSidebarItem::snapshot() const
+	{
+		return m_verts;
+	}
+
+	std::vector<HexVertsU>& AppSidebarItem::mutableVerts()
+	{
+		// snapshots handed out earlier keep the old array
+		if (m_verts.use_count() > 1)
+		{
+			m_verts = std::make_shared<std::vector<HexVertsU>>(*m_verts);
+			m_faceIndex.rebind(*m_verts);
+		}
+		return *m_verts;
+	}
+
+	std::string AppSidebarItem::autosaveFile() const
+	{
+		if (m_file)
+		{
+			return *m_file + ".autosave";
+		}
+		return m_unnamedAutosaveFile;
+	}
+
+	void AppSidebarItem::update()
+	{
+		updateLoad();
+		const std::chrono::steady_clock::time_point now{ std::chrono::steady_clock::now() };
+		if (!loading() && m_autosaveDirty && now - m_lastAutosave >= c_autosaveInterval && !m_autosaver.busy())
+		{
+			m_autosaver.request(autosaveFile(), m_sourceControl.size(), snapshot());
+			m_autosaveDirty = false;
+			m_lastAutosave = now;
 		}
 	}
 
@@ -85,32 +211,54 @@ namespace RSE
 		clear();
 		m_file = _filename;
 		onFileChange();
-		std::ifstream file{};
-		file.open(_filename);
-		cpputils::serialization::Deserializer s{ file };
-		Int size;
-		s >> size;
-		m_sourceControl.setSize(size);
-		onSourceUpdate();
-		onCursorUpdate();
-		std::size_t childrenSize{};
-		s >> childrenSize;
-		m_children.reserve(childrenSize);
-		while (childrenSize > 0)
+		m_loadScheme = std::nullopt;
+		m_loadFuture = std::async(std::launch::async, [_filename]() { return schemeIO::load(_filename); });
+	}
+
+	bool AppSidebarItem::loading() const
+	{
+		return m_loadFuture.valid() || m_loadScheme.has_value();
+	}
+
+	void AppSidebarItem::updateLoad()
+	{
+		if (m_loadFuture.valid() && m_loadFuture.wait_for(std::chrono::seconds::zero()) == std::future_status::ready)
 		{
-			ChildControl& child{ *new ChildControl{m_sourceControl.cursorMin(), m_sourceControl.cursorMax()} };
-			child.randomColor();
-			m_children.push_back(&child);
-			HexVertsU verts;
-			for (IVec3& vert : verts)
+			try
 			{
-				s >> vert.x() >> vert.y() >> vert.z();
+				m_loadScheme = m_loadFuture.get();
+				schemeIO::validate(m_loadScheme->size, m_loadScheme->children);
+				m_sourceControl.setSize(m_loadScheme->size);
+			}
+			catch (const std::exception& _exception)
+			{
+				std::cerr << "Failed to load '" << m_file.value_or("") << "': " << _exception.what() << std::endl;
+				m_loadScheme = std::nullopt;
+				m_file = std::nullopt;
+				onFileChange();
+				return;
+			}
+			m_loadedChildren = 0;
+			onSourceUpdate();
+			onCursorUpdate();
+			m_children.reserve(m_loadScheme->children.size());
+		}
+		if (m_loadScheme)
+		{
+			const std::chrono::steady_clock::time_point deadline{ std::chrono::steady_clock::now() + c_loadBudget };
+			while (m_loadedChildren < m_loadScheme->children.size() && std::chrono::steady_clock::now() < deadline)
+			{
+				ChildControl& child{ *new ChildControl{m_loadScheme->children[m_loadedChildren++]} };
+				child.randomColor();
+				m_children.push_back(&child);
+				onChildAdd();
+			}
+			if (m_loadedChildren == m_loadScheme->children.size())
+			{
+				m_loadScheme = std::nullopt;
+				m_autosaveDirty = false;
 			}
-			child.setVerts(verts);
-			childrenSize--;
-			onChildAdd();
 		}
-		file.close();
 	}
 
 	void AppSidebarItem::load()
@@ -122,40 +270,62 @@ namespace RSE
 		}
 	}
 
-	std::string AppSidebarItem::exportCode() const
+	std::size_t AppSidebarItem::mergeDuplicates()
 	{
-		std::vector<HexVertsU> children{};
-		children.reserve(m_children.size());
-		for (const ChildControl* child : m_children)
+		const std::vector<std::size_t> duplicates{ symmetry::duplicates(*m_verts) };
+		removeChildren(duplicates);
+		return duplicates.size();
+	}
+
+	const AppSidebarItem::ExportCache& AppSidebarItem::exportResult() const
+	{
+		CppExporter exporter{ m_exporter };
+		exporter.name = m_file ? CppExporter::identifier(*m_file) : "";
+		if (exporter.name.empty())
 		{
-			children.push_back(child->hexControl().verts());
+			exporter.name = m_file.value_or("unnamed");
 		}
-		CppExporter exporter{};
-		exporter.name = "";
-		if (m_file)
+		if (m_exportCache && m_exportCache->revision == m_revision && m_exportCache->exporter == exporter)
 		{
-			std::string project{ *m_file };
-			project = project.substr(project.find_last_of("/\\") + 1);
-			project = project.substr(0, project.find_last_of("."));
-			std::cout << project;
-			if (!project.empty() && std::isdigit(project[0]))
-			{
-				project[0] = '_';
-			}
-			for (char& c : project)
+			return *m_exportCache;
+		}
+		const std::vector<HexVertsU>& children{ *m_verts };
+		const std::vector<std::size_t> duplicates{ symmetry::duplicates(children) };
+		std::vector<HexVertsU> unique{};
+		if (!duplicates.empty())
+		{
+			unique.reserve(children.size() - duplicates.size());
+			for (std::size_t i{}, d{}; i < children.size(); i++)
 			{
-				if (!(std::isalnum(c) || c == '_'))
+				if (d < duplicates.size() && duplicates[d] == i)
 				{
-					c = '_';
+					d++;
+				}
+				else
+				{
+					unique.push_back(children[i]);
 				}
 			}
-			exporter.name = project;
 		}
-		if (exporter.name.empty())
+		std::string code{ exporter(m_sourceControl.size(), duplicates.empty() ? children : unique) };
+		m_exportCache = ExportCache{ .revision = m_revision, .exporter = std::move(exporter), .code = std::move(code), .duplicates = duplicates.size() };
+		return *m_exportCache;
+	}
+
+	std::string AppSidebarItem::exportCode() const
+	{
+		return exportResult().code;
+	}
+
+	void AppSidebarItem::reportExport(const std::string& _target) const
+	{
+		const ExportCache& result{ exportResult() };
+		std::cout << "Exported " << m_children.size() - result.duplicates << " children to " << _target;
+		if (result.duplicates)
 		{
-			exporter.name = m_file.value_or("unnamed");
+			std::cout << " (skipped " << result.duplicates << " duplicate children)";
 		}
-		return exporter(m_sourceControl.size(), children);
+		std::cout << std::endl;
 	}
 
 	void AppSidebarItem::setSolidMode(bool _enabled)
@@ -163,9 +333,13 @@ namespace RSE
 		if (m_solidMode != _enabled)
 		{
 			m_solidMode = _enabled;
+			// hidden children are culled when they are shown again
 			for (std::size_t i{}; i < m_children.size(); i++)
 			{
-				onChildUpdate(i);
+				if (shown(*m_children[i]))
+				{
+					onChildViewUpdate(i);
+				}
 			}
 		}
 	}
@@ -175,10 +349,51 @@ namespace RSE
 		return m_solidMode;
 	}
 
+	void AppSidebarItem::setSize(Int _size)
+	{
+		if (_size < minRequiredSize())
+		{
+			throw std::logic_error{ "size smaller than the children extent" };
+		}
+		m_sourceControl.setSize(_size);
+		IVec3 min{ m_sourceControl.cursorMin() }, max{ m_sourceControl.cursorMax() };
+		for (unsigned int d{}; d < 3; d++)
+		{
+			max[d] = std::min(max[d], _size);
+			min[d] = std::min(min[d], max[d]);
+		}
+		m_sourceControl.setCursor(min, max);
+		onSourceUpdate();
+		onCursorUpdate();
+	}
+
+	void AppSidebarItem::setPrecision(Grid::EPrecision _precision)
+	{
+		if (m_precision != _precision)
+		{
+			m_precision = _precision;
+			onPrecisionChange();
+		}
+	}
+
+	Grid::EPrecision AppSidebarItem::precision() const
+	{
+		return m_precision;
+	}
+
+	Real AppSidebarItem::precisionDeviation() const
+	{
+		if (!m_precisionDeviation)
+		{
+			m_precisionDeviation = Grid::precisionDeviation(m_sourceControl.size(), m_sourceControl.displ().verts());
+		}
+		return *m_precisionDeviation;
+	}
+
 	void AppSidebarItem::exportCodeToClipboard() const
 	{
 		glfwSetClipboardString(nullptr, exportCode().c_str());
-		std::cout << "Exported " << m_children.size() << " children to the clipboard" << std::endl;
+		reportExport("the clipboard");
 	}
 
 	void AppSidebarItem::exportCodeToFile() const
@@ -186,14 +401,19 @@ namespace RSE
 		const std::string filename{ cinolib::file_dialog_save() };
 		if (!filename.empty())
 		{
-			std::ofstream file{};
-			file.open(filename);
-			file << exportCode();
-			file.close();
-			std::cout << "Exported " << m_children.size() << " children to '" << filename << "'" << std::endl;
+			exportCodeToFile(filename);
 		}
 	}
 
+	void AppSidebarItem::exportCodeToFile(const std::string& _filename) const
+	{
+		std::ofstream file{};
+		file.open(_filename);
+		file << exportCode();
+		file.close();
+		reportExport("'" + _filename + "'");
+	}
+
 	void AppSidebarItem::addChild()
 	{
 		addChild(m_sourceControl.cursorMin(), m_sourceControl.cursorMax());
@@ -212,6 +432,26 @@ namespace RSE
 		onChildAdd();
 	}
 
+	void AppSidebarItem::addChildren(const std::vector<HexVertsU>& _verts)
+	{
+		if (_verts.empty())
+		{
+			return;
+		}
+		beginBatch();
+		m_children.reserve(m_children.size() + _verts.size());
+		for (const HexVertsU& verts : _verts)
+		{
+			addChild(verts);
+		}
+		endBatch();
+	}
+
+	void AppSidebarItem::generateInCursor(const generators::Params& _params)
+	{
+		addChildren(generators::generate(m_sourceControl.cursorMin(), m_sourceControl.cursorMax(), _params));
+	}
+
 	void AppSidebarItem::removeChild(std::size_t _child)
 	{
 		if (_child >= m_children.size())
@@ -226,11 +466,68 @@ namespace RSE
 		}
 		delete m_children[_child];
 		m_children.erase(m_children.begin() + _child);
+		const HexVertsU oldVerts{ (*m_verts)[_child] };
+		mutableVerts().erase(m_verts->begin() + static_cast<std::ptrdiff_t>(_child));
 		if (m_activeChild > _child)
 		{
 			m_activeChild = *m_activeChild - 1;
 		}
+		const std::vector<std::size_t> neighbors{ m_faceIndex.remove(_child, oldVerts) };
 		onChildRemove(_child);
+		for (const std::size_t neighbor : neighbors)
+		{
+			onChildAdjacencyUpdate(neighbor);
+		}
+	}
+
+	void AppSidebarItem::removeChildren(const std::vector<std::size_t>& _children)
+	{
+		for (std::size_t i{}; i < _children.size(); i++)
+		{
+			if (_children[i] >= m_children.size() || (i && _children[i] <= _children[i - 1]))
+			{
+				throw std::logic_error{ "indices out of bounds or not ascending" };
+			}
+		}
+		if (_children.empty())
+		{
+			return;
+		}
+		beginBatch();
+		if (m_activeChild && std::binary_search(_children.begin(), _children.end(), *m_activeChild))
+		{
+			m_activeChild = std::nullopt;
+			onActiveVertChange();
+		}
+		std::size_t kept{};
+		for (std::size_t i{}, r{}; i < m_children.size(); i++)
+		{
+			if (r < _children.size() && _children[r] == i)
+			{
+				delete m_children[i];
+				r++;
+			}
+			else
+			{
+				if (m_activeChild == i)
+				{
+					m_activeChild = kept;
+				}
+				m_children[kept++] = m_children[i];
+			}
+		}
+		m_children.resize(kept);
+		// listeners rebuild everything from the compacted children
+		onChildrenClear();
+		std::vector<HexVertsU>& verts{ mutableVerts() };
+		verts.reserve(m_children.size());
+		for (const ChildControl* child : m_children)
+		{
+			verts.push_back(child->hexControl().verts());
+		}
+		m_faceIndex = FaceIndex{ verts };
+		updateSelection();
+		endBatch();
 	}
 
 	void AppSidebarItem::setActiveVert(std::size_t _vert)
@@ -277,7 +574,7 @@ namespace RSE
 			if (old)
 			{
 				m_children[*old]->setActive(false);
-				onChildUpdate(*old);
+				onChildViewUpdate(*old);
 			}
 			if (_child)
 			{
@@ -287,7 +584,7 @@ namespace RSE
 				}
 				m_activeChild = _child;
 				m_children[*_child]->setActive(true);
-				onChildUpdate(*_child);
+				onChildViewUpdate(*_child);
 			}
 			onActiveVertChange();
 		}
@@ -298,6 +595,11 @@ namespace RSE
 		return m_sourceControl;
 	}
 
+	const FaceIndex& AppSidebarItem::faceIndex() const
+	{
+		return m_faceIndex;
+	}
+
 	AppSidebarItem::ChildControls AppSidebarItem::children() const
 	{
 		return ChildControls{ m_children };
@@ -317,13 +619,21 @@ namespace RSE
 	{
 		if (_enabled != m_singleMode)
 		{
+			std::vector<bool> wasShown(m_children.size());
+			for (std::size_t i{}; i < m_children.size(); i++)
+			{
+				wasShown[i] = shown(*m_children[i]);
+			}
 			m_singleMode = _enabled;
 			m_hasAnySelected = false;
 			for (std::size_t i{}; i < m_children.size(); i++)
 			{
 				m_children[i]->setVisible(true);
 				m_children[i]->setSelected(false);
-				onChildUpdate(i);
+				if (wasShown[i] != shown(*m_children[i]))
+				{
+					onChildViewUpdate(i);
+				}
 			}
 		}
 	}
@@ -364,42 +674,70 @@ namespace RSE
 
 	void AppSidebarItem::addChildrenCursorGrid()
 	{
-		const IVec3 min{ m_sourceControl.cursorMin() };
-		const IVec3 max{ m_sourceControl.cursorMax() };
-		IVec3 a, b;
-		for (Int x{ min.x() }; x < max.x(); x++)
+		addChildren(generators::uniform(m_sourceControl.cursorMin(), m_sourceControl.cursorMax(), 1));
+	}
+
+	std::vector<std::size_t> AppSidebarItem::shownIndices() const
+	{
+		std::vector<std::size_t> indices{};
+		for (std::size_t i{}; i < m_children.size(); i++)
 		{
-			a.x() = x;
-			b.x() = x + 1;
-			for (Int y{ min.y() }; y < max.y(); y++)
+			if (shown(*m_children[i]))
 			{
-				a.y() = y;
-				b.y() = y + 1;
-				for (Int z{ min.z() }; z < max.z(); z++)
-				{
-					a.z() = z;
-					b.z() = z + 1;
-					addChild(a, b);
-				}
+				indices.push_back(i);
 			}
 		}
+		return indices;
 	}
 
-	void AppSidebarItem::flipShown()
+	std::vector<HexVertsU> AppSidebarItem::childrenVerts(const std::vector<std::size_t>& _children) const
 	{
-		for (std::size_t i{}; i < m_children.size(); i++)
+		std::vector<HexVertsU> verts{};
+		verts.reserve(_children.size());
+		for (const std::size_t i : _children)
 		{
-			ChildControl& child{ *m_children[i] };
-			if (shown(child))
+			verts.push_back(m_children[i]->hexControl().verts());
+		}
+		return verts;
+	}
+
+	void AppSidebarItem::setChildrenVerts(const std::vector<std::size_t>& _children, const std::vector<HexVertsU>& _verts)
+	{
+		if (_children.empty())
+		{
+			return;
+		}
+		std::vector<std::size_t> neighbors{};
+		std::vector<HexVertsU>& verts{ mutableVerts() };
+		for (std::size_t c{}; c < _children.size(); c++)
+		{
+			m_children[_children[c]]->setVerts(_verts[c]);
+			const HexVertsU oldVerts{ verts[_children[c]] };
+			verts[_children[c]] = _verts[c];
+			const std::vector<std::size_t> childNeighbors{ m_faceIndex.update(_children[c], oldVerts) };
+			neighbors.insert(neighbors.end(), childNeighbors.begin(), childNeighbors.end());
+		}
+		invalidate();
+		onChildrenUpdate(_children);
+		std::sort(neighbors.begin(), neighbors.end());
+		neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+		for (const std::size_t neighbor : neighbors)
+		{
+			if (!std::binary_search(_children.begin(), _children.end(), neighbor))
 			{
-				HexVertsU verts{ child.hexControl().verts() };
-				hexUtils::flipVerts(verts, editDim, m_sourceControl.size());
-				child.setVerts(verts);
-				onChildUpdate(i);
+				onChildAdjacencyUpdate(neighbor);
 			}
 		}
 	}
 
+	void AppSidebarItem::flipShown()
+	{
+		const std::vector<std::size_t> indices{ shownIndices() };
+		std::vector<HexVertsU> verts{ childrenVerts(indices) };
+		hexUtils::flipVerts(std::span{ verts }, editDim, m_sourceControl.size());
+		setChildrenVerts(indices, verts);
+	}
+
 	void AppSidebarItem::cloneShown()
 	{
 		const std::size_t maxI{ m_children.size() };
@@ -487,48 +825,97 @@ namespace RSE
 		}
 		IVec3 offset{ 0,0,0 };
 		offset[dim] = _advance ? 1 : static_cast<Int>(-1);
-		for (std::size_t i{}; i < m_children.size(); i++)
-		{
-			ChildControl& child{ *m_children[i] };
-			if (shown(child))
-			{
-				HexVertsU verts{ child.hexControl().verts() };
-				hexUtils::translateVerts(verts, offset);
-				child.setVerts(verts);
-				onChildUpdate(i);
-			}
-		}
+		const std::vector<std::size_t> indices{ shownIndices() };
+		std::vector<HexVertsU> verts{ childrenVerts(indices) };
+		hexUtils::translateVerts(std::span{ verts }, offset);
+		setChildrenVerts(indices, verts);
 	}
 
 	void AppSidebarItem::removeShown()
 	{
-		std::vector<std::size_t> toRemove{};
-		for (std::size_t i{}; i < m_children.size(); i++)
+		removeChildren(shownIndices());
+	}
+
+	void AppSidebarItem::rotateShown()
+	{
+		const std::vector<std::size_t> indices{ shownIndices() };
+		std::vector<HexVertsU> verts{ childrenVerts(indices) };
+		hexUtils::rotateVerts(std::span{ verts }, editDim, m_sourceControl.size());
+		setChildrenVerts(indices, verts);
+	}
+
+	void AppSidebarItem::applySymmetryShown(const symmetry::Symmetry& _symmetry, bool _copy)
+	{
+		const std::vector<std::size_t> indices{ shownIndices() };
+		std::vector<HexVertsU> verts{ childrenVerts(indices) };
+		symmetry::apply(std::span{ verts }, _symmetry, m_sourceControl.size());
+		// keyed on the canonical form, so that the same hex with its vertices relabeled is a duplicate too
+		std::unordered_set<HexVertsU, symmetry::HexHasher> existing{};
+		existing.reserve(m_children.size() + (_copy ? verts.size() : 0));
+		for (std::size_t i{}, s{}; i < m_children.size(); i++)
 		{
-			if (shown(*m_children[i]))
+			if (_copy || s == indices.size() || indices[s] != i)
 			{
-				toRemove.push_back(i);
+				existing.insert(symmetry::canonical((*m_verts)[i]));
+			}
+			else
+			{
+				s++;
 			}
 		}
-		for (std::size_t iPlusOne{ m_children.size() }; iPlusOne > 0; iPlusOne--)
+		if (_copy)
 		{
-			removeChild(iPlusOne - 1);
+			std::vector<HexVertsU> copies{};
+			copies.reserve(verts.size());
+			for (const HexVertsU& child : verts)
+			{
+				if (existing.insert(symmetry::canonical(child)).second)
+				{
+					copies.push_back(child);
+				}
+			}
+			addChildren(copies);
+		}
+		else
+		{
+			std::vector<std::size_t> duplicates{};
+			for (std::size_t s{}; s < indices.size(); s++)
+			{
+				if (!existing.insert(symmetry::canonical(verts[s])).second)
+				{
+					duplicates.push_back(indices[s]);
+				}
+			}
+			beginBatch();
+			setChildrenVerts(indices, verts);
+			removeChildren(duplicates);
+			endBatch();
 		}
 	}
 
-	void AppSidebarItem::rotateShown()
+	void AppSidebarItem::symmetrizeShown()
 	{
-		for (std::size_t i{}; i < m_children.size(); i++)
+		const std::vector<HexVertsU> shown{ childrenVerts(shownIndices()) };
+		std::unordered_set<HexVertsU, symmetry::HexHasher> existing{};
+		existing.reserve(m_children.size() + shown.size() * symmetry::symmetries.size());
+		for (const HexVertsU& child : *m_verts)
 		{
-			ChildControl& child{ *m_children[i] };
-			if (shown(child))
+			existing.insert(symmetry::canonical(child));
+		}
+		std::vector<HexVertsU> copies{};
+		for (const symmetry::Symmetry& transform : symmetry::symmetries)
+		{
+			std::vector<HexVertsU> verts{ shown };
+			symmetry::apply(std::span{ verts }, transform, m_sourceControl.size());
+			for (const HexVertsU& child : verts)
 			{
-				HexVertsU verts{ child.hexControl().verts() };
-				hexUtils::rotateVerts(verts, editDim, m_sourceControl.size());
-				child.setVerts(verts);
-				onChildUpdate(i);
+				if (existing.insert(symmetry::canonical(child)).second)
+				{
+					copies.push_back(child);
+				}
 			}
 		}
+		addChildren(copies);
 	}
 
 	void AppSidebarItem::setChildSelected(std::size_t _child, bool _selected)
@@ -543,7 +930,7 @@ namespace RSE
 				updateSelection();
 				if (wasShown != shown(child))
 				{
-					onChildUpdate(_child);
+					onChildViewUpdate(_child);
 				}
 			}
 		}
@@ -577,17 +964,38 @@ namespace RSE
 				break;
 			}
 		}
-		if (m_hasAnySelected != hadAnySelected)
+		if (m_hasAnySelected != hadAnySelected && !m_singleMode)
 		{
+			// only the visible children that are neither active nor selected toggle
 			for (std::size_t i{}; i < m_children.size(); i++)
 			{
-				onChildUpdate(i);
+				const ChildControl& child{ *m_children[i] };
+				if (child.visible() && !child.active() && !child.selected())
+				{
+					onChildViewUpdate(i);
+				}
 			}
 		}
 	}
 
 	void AppSidebarItem::draw()
 	{
+		// loading
+		if (loading())
+		{
+			ImGui::Spacing();
+			if (m_loadScheme)
+			{
+				const std::size_t total{ m_loadScheme->children.size() };
+				const std::string progress{ std::to_string(m_loadedChildren) + "/" + std::to_string(total) + " children" };
+				ImGui::ProgressBar(static_cast<float>(m_loadedChildren) / static_cast<float>(total), ImVec2{ -1.0f, 0.0f }, progress.c_str());
+			}
+			else
+			{
+				ImGui::TextDisabled("Reading '%s'...", m_file.value_or("").c_str());
+			}
+			return;
+		}
 		// source
 		ImGui::SetNextItemOpen(false, ImGuiCond_Once);
 		if (ImGui::CollapsingHeader("Source"))
@@ -596,12 +1004,21 @@ namespace RSE
 			switch (m_sourceControl.draw(minRequiredSize()))
 			{
 				case SourceControl::EResult::DoubledSize:
-					for (ChildControl* child : m_children)
+				{
+					std::vector<HexVertsU> verts{};
+					verts.reserve(m_children.size());
+					for (const ChildControl* child : m_children)
 					{
-						HexVertsU verts{ child->hexControl().verts() };
-						hexUtils::scaleVerts(verts, IVec3{ 2,2,2 });
-						child->setVerts(verts);
+						verts.push_back(child->hexControl().verts());
 					}
+					hexUtils::scaleVerts(std::span{ verts }, IVec3{ 2,2,2 });
+					for (std::size_t i{}; i < m_children.size(); i++)
+					{
+						m_children[i]->setVerts(verts[i]);
+					}
+					mutableVerts() = std::move(verts);
+					m_faceIndex = FaceIndex{ *m_verts };
+				}
 				case SourceControl::EResult::Updated:
 					onSourceUpdate();
 				case SourceControl::EResult::CursorUpdated:
@@ -610,6 +1027,13 @@ namespace RSE
 				default:
 					break;
 			}
+			ImGui::Spacing();
+			int precision{ static_cast<int>(m_precision) };
+			ImGui::RadioButton("Single precision", &precision, static_cast<int>(Grid::EPrecision::Single));
+			ImGui::SameLine();
+			ImGui::RadioButton("Double precision", &precision, static_cast<int>(Grid::EPrecision::Double));
+			setPrecision(static_cast<Grid::EPrecision>(precision));
+			ImGui::TextDisabled("Max single precision deviation: %g", precisionDeviation());
 		}
 		// edit
 		ImGui::Spacing();
@@ -654,6 +1078,24 @@ namespace RSE
 			{
 				translateShown(true);
 			}
+			ImGui::Spacing();
+			int symmetryIndex{ static_cast<int>(m_symmetry) };
+			ImGui::SliderInt("Symmetry", &symmetryIndex, 1, static_cast<int>(symmetry::symmetries.size()) - 1, symmetry::name(symmetry::symmetries[m_symmetry]).c_str());
+			m_symmetry = static_cast<std::size_t>(symmetryIndex);
+			if (ImGui::SmallButton("Apply"))
+			{
+				applySymmetryShown(symmetry::symmetries[m_symmetry], false);
+			}
+			ImGui::SameLine();
+			if (ImGui::SmallButton("Copy"))
+			{
+				applySymmetryShown(symmetry::symmetries[m_symmetry], true);
+			}
+			ImGui::SameLine();
+			if (ImGui::SmallButton("Symmetrize"))
+			{
+				symmetrizeShown();
+			}
 			if (!m_singleMode)
 			{
 				ImGui::Spacing();
@@ -721,7 +1163,7 @@ namespace RSE
 				}
 				if (wasShown != shown(child))
 				{
-					onChildUpdate(i);
+					onChildViewUpdate(i);
 				}
 				switch (result)
 				{
@@ -733,6 +1175,9 @@ namespace RSE
 						}
 						m_sourceControl.setSize(std::max(m_sourceControl.size(), child.maxSize()));
 						break;
+					case ChildControl::EResult::ColorUpdated:
+						onChildViewUpdate(i);
+						break;
 					case ChildControl::EResult::Removed:
 						removeChild(i);
 						--i;
@@ -779,6 +1224,90 @@ namespace RSE
 			{
 				randomColors();
 			}
+			// generators
+			ImGui::Spacing();
+			int family{ static_cast<int>(m_generator.family) };
+			ImGui::Combo("Family", &family, generators::familyNames.data(), static_cast<int>(generators::familyNames.size()));
+			m_generator.family = static_cast<generators::EFamily>(family);
+			ImGui::SliderInt("Cell size", &m_generator.cellSize, 1, m_sourceControl.size(), "%d", ImGuiSliderFlags_AlwaysClamp);
+			if (m_generator.family == generators::EFamily::Graded || m_generator.family == generators::EFamily::Transition3)
+			{
+				int dim{ static_cast<int>(m_generator.dim) };
+				ImGui::TextDisabled(m_generator.family == generators::EFamily::Graded ? "Grading" : "Fine side");
+				ImGui::SameLine();
+				ImGui::RadioButton("x##generatorDim", &dim, 0);
+				ImGui::SameLine();
+				ImGui::RadioButton("y##generatorDim", &dim, 1);
+				ImGui::SameLine();
+				ImGui::RadioButton("z##generatorDim", &dim, 2);
+				m_generator.dim = static_cast<hexUtils::EDim>(dim);
+			}
+			if (m_generator.family == generators::EFamily::Transition3)
+			{
+				int dim{ static_cast<int>(m_generator.splitDim) };
+				ImGui::TextDisabled("Split");
+				ImGui::SameLine();
+				ImGui::RadioButton("x##generatorSplitDim", &dim, 0);
+				ImGui::SameLine();
+				ImGui::RadioButton("y##generatorSplitDim", &dim, 1);
+				ImGui::SameLine();
+				ImGui::RadioButton("z##generatorSplitDim", &dim, 2);
+				m_generator.splitDim = static_cast<hexUtils::EDim>(dim);
+			}
+			if (ImGui::SmallButton("Generate in cursor"))
+			{
+				try
+				{
+					generateInCursor(m_generator);
+				}
+				catch (const std::logic_error& _error)
+				{
+					std::cerr << "Generation failed: " << _error.what() << std::endl;
+				}
+			}
+		}
+		// validation
+		ImGui::Spacing();
+		ImGui::SetNextItemOpen(false, ImGuiCond_Once);
+		if (ImGui::CollapsingHeader("Validation"))
+		{
+			ImGui::Spacing();
+			if (ImGui::SmallButton("Validate"))
+			{
+				std::cout << validate() << std::endl;
+			}
+			ImGui::SameLine();
+			if (ImGui::SmallButton("Merge duplicates"))
+			{
+				std::cout << "Merged " << mergeDuplicates() << " duplicate children" << std::endl;
+			}
+			if (m_validation)
+			{
+				const SchemeValidator::Report& report{ *m_validation };
+				ImGui::Spacing();
+				if (report.valid())
+				{
+					ImGui::TextColored(ImVec4{ 0.0f,1.0f,0.0f,1.0f }, "Valid");
+				}
+				else
+				{
+					ImGui::TextColored(ImVec4{ 1.0f,1.0f,0.0f,1.0f }, "Invalid");
+				}
+				ImGui::TextDisabled("%d children with duplicate vertices", static_cast<int>(report.invalidChildren));
+				ImGui::TextDisabled("%d/%d uncovered cells", static_cast<int>(report.gapCells), static_cast<int>(report.cells));
+				ImGui::TextDisabled("%d/%d overlapping cells", static_cast<int>(report.overlapCells), static_cast<int>(report.cells));
+				ImGui::TextDisabled("%d non-conforming faces", static_cast<int>(report.nonConformingFaces));
+			}
+		}
+		// export
+		ImGui::Spacing();
+		ImGui::SetNextItemOpen(false, ImGuiCond_Once);
+		if (ImGui::CollapsingHeader("Export"))
+		{
+			ImGui::Spacing();
+			ImGui::Checkbox("Faces", &m_exporter.faces);
+			ImGui::SameLine();
+			ImGui::Checkbox("Edges", &m_exporter.edges);
 		}
 		// command bar
 		ImGui::Spacing();
@@ -823,7 +1352,7 @@ namespace RSE
 		for (std::size_t i{}; i < m_children.size(); i++)
 		{
 			m_children[i]->randomColor();
-			onChildUpdate(i);
+			onChildViewUpdate(i);
 		}
 	}
 
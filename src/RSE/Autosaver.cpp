@@ -0,0 +1,83 @@
+#include <RSE/Autosaver.hpp>
+
+#include <RSE/schemeIO.hpp>
+#include <iostream>
+#include <exception>
+#include <utility>
+#include <filesystem>
+
+namespace RSE
+{
+
+	Autosaver::Autosaver() : m_mutex{}, m_condition{}, m_idle{}, m_pending{}, m_busy{ false }, m_stop{ false }, m_thread{ [this]() { run(); } }
+	{}
+
+	Autosaver::~Autosaver()
+	{
+		{
+			const std::lock_guard lock{ m_mutex };
+			m_stop = true;
+		}
+		m_condition.notify_one();
+		m_thread.join();
+	}
+
+	void Autosaver::run()
+	{
+		std::unique_lock lock{ m_mutex };
+		while (true)
+		{
+			m_condition.wait(lock, [this]() { return m_stop || m_pending; });
+			if (m_stop)
+			{
+				return;
+			}
+			const Job job{ std::move(*m_pending) };
+			m_pending = std::nullopt;
+			m_busy = true;
+			lock.unlock();
+			try
+			{
+				schemeIO::writeAtomic(job.filename, [&job](std::ostream& _stream) {
+					schemeIO::write(_stream, job.size, *job.children);
+				});
+			}
+			catch (const std::exception& _exception)
+			{
+				std::cerr << "Autosave to '" << job.filename << "' failed: " << _exception.what() << std::endl;
+			}
+			lock.lock();
+			m_busy = false;
+			m_idle.notify_all();
+		}
+	}
+
+	void Autosaver::request(const std::string& _filename, Int _size, Children _children)
+	{
+		{
+			const std::lock_guard lock{ m_mutex };
+			m_pending = Job{ _filename, _size, std::move(_children) };
+		}
+		m_condition.notify_one();
+	}
+
+	bool Autosaver::busy() const
+	{
+		const std::lock_guard lock{ m_mutex };
+		return m_busy || m_pending.has_value();
+	}
+
+	void Autosaver::discard(const std::string& _filename)
+	{
+		std::unique_lock lock{ m_mutex };
+		if (m_pending && m_pending->filename == _filename)
+		{
+			m_pending = std::nullopt;
+		}
+		m_idle.wait(lock, [this]() { return !m_busy; });
+		lock.unlock();
+		std::error_code error{};
+		std::filesystem::remove(_filename, error);
+	}
+
+}
\ No newline at end of file
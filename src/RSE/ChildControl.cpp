@@ -10,22 +10,8 @@
 namespace RSE
 {
 
-	void ChildControl::update()
-	{
-		m_maxSize = 0;
-		for (const IVec3& vert : m_hexControl.verts())
-		{
-			m_maxSize = std::max({ m_maxSize, vert.x(), vert.y(), vert.z() });
-		}
-	}
-
-	ChildControl::ChildControl(const HexVertsU& _verts) : m_active{ false }, m_visible{ true }, m_selected{ false }, m_hexControl{ _verts, true }, m_style{ 0.0f,0.0f,0.5f }, m_maxSize{}
-	{
-		for (const IVec3& vert : _verts)
-		{
-			m_maxSize = std::max({ m_maxSize, vert.x(), vert.y(), vert.z() });
-		}
-	}
+	ChildControl::ChildControl(const HexVertsU& _verts) : m_active{ false }, m_visible{ true }, m_selected{ false }, m_hexControl{ _verts, true }, m_style{ 0.0f,0.0f,0.5f }
+	{}
 
 	ChildControl::ChildControl(const IVec3& _min, const IVec3& _max) : ChildControl{ IHexControl::cubeVerts(_min, _max) }
 	{}
@@ -42,9 +28,7 @@ namespace RSE
 
 	void ChildControl::randomColor()
 	{
-		std::random_device device;
-		std::mt19937 gen(device());
-		std::uniform_int_distribution<> distr(25, 63);
+		static std::mt19937 gen{ std::random_device{}() };
 		m_style = Style{
 			std::uniform_real_distribution<float>(0.0f,360.0f)(gen),
 			std::uniform_real_distribution<float>(0.5f,1.0f)(gen),
@@ -75,7 +59,6 @@ namespace RSE
 	void ChildControl::setVerts(const HexVertsU& _verts)
 	{
 		m_hexControl.setVerts(_verts);
-		update();
 	}
 
 	void ChildControl::setActiveVert(std::size_t _index)
@@ -86,7 +69,6 @@ namespace RSE
 	void ChildControl::setActiveVert(const IVec3& _vert)
 	{
 		m_hexControl.setActiveVert(_vert);
-		update();
 	}
 
 	void ChildControl::setActive(bool _active)
@@ -106,7 +88,13 @@ namespace RSE
 
 	Int ChildControl::maxSize() const
 	{
-		return m_maxSize;
+		// computed on demand to keep children small
+		Int maxSize{};
+		for (const IVec3& vert : m_hexControl.verts())
+		{
+			maxSize = std::max({ maxSize, vert.x(), vert.y(), vert.z() });
+		}
+		return maxSize;
 	}
 
 	ChildControl::EResult ChildControl::draw(const IVec3& _min, const IVec3& _max, const std::optional<HexVertsU>& _copiedVerts, const std::optional<IVec3>& _copiedVert, EVisibilityMode _visibilityMode)
@@ -158,15 +146,11 @@ namespace RSE
 			}
 		}
 		Style::popImGui();
-		if (updated)
-		{
-			update();
-		}
 		if (!keep)
 		{
 			return EResult::Removed;
 		}
-		return updated || colorUpdated ? EResult::Updated : EResult::None;
+		return updated ? EResult::Updated : colorUpdated ? EResult::ColorUpdated : EResult::None;
 	}
 
 }
\ No newline at end of file
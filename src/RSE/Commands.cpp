@@ -0,0 +1,473 @@
+#include <RSE/Commands.hpp>
+
+#include <RSE/symmetry.hpp>
+#include <RSE/generators.hpp>
+#include <sstream>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <optional>
+#include <algorithm>
+
+namespace RSE
+{
+
+	namespace
+	{
+
+		template<typename TValue>
+		TValue parse(std::istream& _stream, const char* _what)
+		{
+			TValue value{};
+			if (!(_stream >> value))
+			{
+				throw std::runtime_error{ std::string{ "expected " } + _what };
+			}
+			return value;
+		}
+
+		IVec3 parseVec(std::istream& _stream)
+		{
+			IVec3 vec;
+			for (unsigned int d{}; d < 3; d++)
+			{
+				vec[d] = parse<Int>(_stream, "an integer coordinate");
+			}
+			return vec;
+		}
+
+		bool parseSign(std::istream& _stream)
+		{
+			const std::string sign{ parse<std::string>(_stream, "'+' or '-'") };
+			if (sign != "+" && sign != "-")
+			{
+				throw std::runtime_error{ "expected '+' or '-'" };
+			}
+			return sign == "+";
+		}
+
+		bool parseSwitch(std::istream& _stream)
+		{
+			const std::string value{ parse<std::string>(_stream, "'on' or 'off'") };
+			if (value != "on" && value != "off")
+			{
+				throw std::runtime_error{ "expected 'on' or 'off'" };
+			}
+			return value == "on";
+		}
+
+		hexUtils::EDim parseDim(std::istream& _stream)
+		{
+			const std::string dim{ parse<std::string>(_stream, "'x', 'y' or 'z'") };
+			if (dim != "x" && dim != "y" && dim != "z")
+			{
+				throw std::runtime_error{ "expected 'x', 'y' or 'z'" };
+			}
+			return static_cast<hexUtils::EDim>(dim[0] - 'x');
+		}
+
+		std::string parseRest(std::istream& _stream, const char* _what)
+		{
+			std::string rest{};
+			std::getline(_stream >> std::ws, rest);
+			if (rest.empty())
+			{
+				throw std::runtime_error{ std::string{ "expected " } + _what };
+			}
+			return rest;
+		}
+
+		void expectEnd(std::istream& _stream)
+		{
+			std::string extra{};
+			if (_stream >> extra)
+			{
+				throw std::runtime_error{ "unexpected '" + extra + "'" };
+			}
+		}
+
+		class Batch final
+		{
+
+		private:
+
+			AppSidebarItem& m_app;
+
+		public:
+
+			Batch(AppSidebarItem& _app) : m_app{ _app }
+			{
+				m_app.beginBatch();
+			}
+
+			Batch(const Batch&) = delete;
+
+			Batch& operator=(const Batch&) = delete;
+
+			~Batch()
+			{
+				m_app.endBatch();
+			}
+
+		};
+
+	}
+
+	Commands::Commands(AppSidebarItem& _app) : m_app{ _app }
+	{}
+
+	void Commands::run(std::string_view _line, std::ostream& _output)
+	{
+		std::istringstream stream{ std::string{ _line } };
+		std::string command{};
+		if (!(stream >> command) || command.starts_with('#'))
+		{
+			return;
+		}
+		if (m_app.loading())
+		{
+			throw std::runtime_error{ "cannot run commands while loading" };
+		}
+		const auto childIndex{ [this](std::istream& _stream) {
+			const std::size_t child{ parse<std::size_t>(_stream, "a child index") };
+			if (child >= m_app.children().size())
+			{
+				throw std::runtime_error{ "child index out of bounds" };
+			}
+			return child;
+		} };
+		const auto checkVert{ [this](const IVec3& _vert) {
+			for (unsigned int d{}; d < 3; d++)
+			{
+				if (_vert[d] < 0 || _vert[d] > m_app.source().size())
+				{
+					throw std::runtime_error{ "vertex out of bounds" };
+				}
+			}
+		} };
+		// commands that only read the model need no batch
+		std::optional<Batch> batch{};
+		if (command != "help" && command != "validate" && command != "count" && command != "memory" && command != "save" && command != "export")
+		{
+			batch.emplace(m_app);
+		}
+		if (command == "help")
+		{
+			printHelp(_output);
+		}
+		else if (command == "size")
+		{
+			const Int size{ parse<Int>(stream, "a size") };
+			expectEnd(stream);
+			m_app.setSize(size);
+		}
+		else if (command == "cursor")
+		{
+			const IVec3 min{ parseVec(stream) };
+			const IVec3 max{ parseVec(stream) };
+			expectEnd(stream);
+			m_app.setCursor(min, max);
+		}
+		else if (command == "move-cursor")
+		{
+			const bool advance{ parseSign(stream) };
+			expectEnd(stream);
+			m_app.translateCursor(advance);
+		}
+		else if (command == "scale-cursor")
+		{
+			const bool advance{ parseSign(stream) };
+			expectEnd(stream);
+			m_app.scaleCursor(advance);
+		}
+		else if (command == "hide-cursor")
+		{
+			const bool hidden{ parseSwitch(stream) };
+			expectEnd(stream);
+			m_app.setHideCursor(hidden);
+		}
+		else if (command == "dim")
+		{
+			const hexUtils::EDim dim{ parseDim(stream) };
+			expectEnd(stream);
+			m_app.editDim = dim;
+		}
+		else if (command == "add")
+		{
+			std::string first{};
+			if (stream >> first)
+			{
+				std::istringstream verts{ first + ' ' + parseRest(stream, "24 integer coordinates") };
+				HexVertsU hex;
+				for (IVec3& vert : hex)
+				{
+					vert = parseVec(verts);
+					checkVert(vert);
+				}
+				expectEnd(verts);
+				m_app.addChild(hex);
+			}
+			else
+			{
+				m_app.addChild();
+			}
+		}
+		else if (command == "grid")
+		{
+			expectEnd(stream);
+			m_app.addChildrenCursorGrid();
+		}
+		else if (command == "generate")
+		{
+			const std::string family{ parse<std::string>(stream, "a generator family") };
+			const auto it{ std::find(generators::familyNames.begin(), generators::familyNames.end(), family) };
+			if (it == generators::familyNames.end())
+			{
+				throw std::runtime_error{ "unknown generator family '" + family + "'" };
+			}
+			generators::Params params{};
+			params.family = static_cast<generators::EFamily>(it - generators::familyNames.begin());
+			params.cellSize = parse<Int>(stream, "a cell size");
+			params.dim = m_app.editDim;
+			if (params.family == generators::EFamily::Transition3)
+			{
+				params.splitDim = parseDim(stream);
+			}
+			expectEnd(stream);
+			m_app.generateInCursor(params);
+		}
+		else if (command == "remove")
+		{
+			const std::size_t child{ childIndex(stream) };
+			expectEnd(stream);
+			m_app.removeChild(child);
+		}
+		else if (command == "remove-shown")
+		{
+			expectEnd(stream);
+			m_app.removeShown();
+		}
+		else if (command == "clear")
+		{
+			expectEnd(stream);
+			m_app.clear();
+		}
+		else if (command == "activate")
+		{
+			const std::string child{ parse<std::string>(stream, "a child index or 'none'") };
+			expectEnd(stream);
+			if (child == "none")
+			{
+				m_app.setActiveChild(std::nullopt);
+			}
+			else
+			{
+				std::istringstream index{ child };
+				m_app.setActiveChild(childIndex(index));
+			}
+		}
+		else if (command == "vert")
+		{
+			const std::size_t vert{ parse<std::size_t>(stream, "a vertex index") };
+			expectEnd(stream);
+			if (vert >= 8)
+			{
+				throw std::runtime_error{ "vertex index out of bounds" };
+			}
+			m_app.setActiveVert(vert);
+		}
+		else if (command == "set")
+		{
+			const IVec3 vert{ parseVec(stream) };
+			expectEnd(stream);
+			checkVert(vert);
+			m_app.setActiveVert(vert);
+		}
+		else if (command == "cube")
+		{
+			expectEnd(stream);
+			m_app.cubeActive();
+		}
+		else if (command == "select" || command == "deselect")
+		{
+			const bool selected{ command == "select" };
+			const std::string child{ parse<std::string>(stream, "a child index or 'all'") };
+			expectEnd(stream);
+			if (child == "all")
+			{
+				m_app.setAllSelected(selected);
+			}
+			else
+			{
+				std::istringstream index{ child };
+				m_app.setChildSelected(childIndex(index), selected);
+			}
+		}
+		else if (command == "single" || command == "solid")
+		{
+			const bool enabled{ parseSwitch(stream) };
+			expectEnd(stream);
+			if (command == "single")
+			{
+				m_app.setSingleMode(enabled);
+			}
+			else
+			{
+				m_app.setSolidMode(enabled);
+			}
+		}
+		else if (command == "flip")
+		{
+			expectEnd(stream);
+			m_app.flipShown();
+		}
+		else if (command == "rotate")
+		{
+			expectEnd(stream);
+			m_app.rotateShown();
+		}
+		else if (command == "translate")
+		{
+			const bool advance{ parseSign(stream) };
+			expectEnd(stream);
+			m_app.translateShown(advance);
+		}
+		else if (command == "clone")
+		{
+			expectEnd(stream);
+			m_app.cloneShown();
+		}
+		else if (command == "symmetry")
+		{
+			const std::size_t index{ parse<std::size_t>(stream, "a symmetry index") };
+			std::string copy{};
+			stream >> copy;
+			expectEnd(stream);
+			if (index >= symmetry::symmetries.size())
+			{
+				throw std::runtime_error{ "symmetry index out of bounds" };
+			}
+			if (!copy.empty() && copy != "copy")
+			{
+				throw std::runtime_error{ "expected 'copy'" };
+			}
+			m_app.applySymmetryShown(symmetry::symmetries[index], !copy.empty());
+		}
+		else if (command == "symmetrize")
+		{
+			expectEnd(stream);
+			m_app.symmetrizeShown();
+		}
+		else if (command == "merge")
+		{
+			expectEnd(stream);
+			_output << "Merged " << m_app.mergeDuplicates() << " duplicate children" << std::endl;
+		}
+		else if (command == "validate")
+		{
+			expectEnd(stream);
+			_output << m_app.validate() << std::endl;
+		}
+		else if (command == "count")
+		{
+			expectEnd(stream);
+			_output << m_app.children().size() << " children" << std::endl;
+		}
+		else if (command == "memory")
+		{
+			expectEnd(stream);
+			MemoryReport report{};
+			m_app.memoryReport(report);
+			_output << report << std::endl;
+		}
+		else if (command == "load")
+		{
+			m_app.load(parseRest(stream, "a file name"));
+			while (m_app.loading())
+			{
+				m_app.update();
+				std::this_thread::yield();
+			}
+		}
+		else if (command == "save")
+		{
+			m_app.saveAs(parseRest(stream, "a file name"));
+		}
+		else if (command == "export")
+		{
+			m_app.exportCodeToFile(parseRest(stream, "a file name"));
+		}
+		else
+		{
+			throw std::runtime_error{ "unknown command '" + command + "'" };
+		}
+	}
+
+	std::size_t Commands::runScript(std::istream& _script, std::ostream& _output)
+	{
+		const Batch batch{ m_app };
+		std::size_t count{};
+		std::string line{};
+		for (std::size_t number{ 1 }; std::getline(_script, line); number++)
+		{
+			try
+			{
+				run(line, _output);
+			}
+			catch (const std::exception& _exception)
+			{
+				throw std::runtime_error{ "line " + std::to_string(number) + ": " + _exception.what() };
+			}
+			count++;
+		}
+		return count;
+	}
+
+	std::size_t Commands::runFile(const std::string& _filename, std::ostream& _output)
+	{
+		std::ifstream file{};
+		file.open(_filename);
+		if (!file)
+		{
+			throw std::runtime_error{ "cannot open '" + _filename + "'" };
+		}
+		return runScript(file, _output);
+	}
+
+	void Commands::printHelp(std::ostream& _output)
+	{
+		_output
+			<< "size <n>                       set the source size\n"
+			<< "cursor <min xyz> <max xyz>     set the cursor box\n"
+			<< "move-cursor +|-                translate the cursor along the edit dimension\n"
+			<< "scale-cursor +|-               expand or shrink the cursor along the edit dimension\n"
+			<< "hide-cursor on|off             toggle the cursor grid\n"
+			<< "dim x|y|z                      set the edit dimension (also used by graded and transition3)\n"
+			<< "add [<8 xyz verts>]            add a child, filling the cursor if no vertices are given\n"
+			<< "grid                           add a unit child for each cell of the cursor\n"
+			<< "generate <family> <cell>       fill the cursor with a uniform, graded or transition27 family\n"
+			<< "generate transition3 <cell> x|y|z\n"
+			<< "                               fill the cursor with 1-to-3 templates split along x|y|z\n"
+			<< "remove <child>                 remove a child\n"
+			<< "remove-shown                   remove the shown children\n"
+			<< "clear                          remove every child\n"
+			<< "activate <child>|none          set the active child\n"
+			<< "vert <0-7>                     set the active vertex\n"
+			<< "set <xyz>                      move the active vertex\n"
+			<< "cube                           make the active child fill the cursor\n"
+			<< "select|deselect <child>|all    change the selection\n"
+			<< "single|solid on|off            toggle single or solid mode\n"
+			<< "flip | rotate                  flip or rotate the shown children along the edit dimension\n"
+			<< "translate +|-                  translate the shown children along the edit dimension\n"
+			<< "clone                          duplicate the shown children\n"
+			<< "symmetry <0-47> [copy]         apply a cube symmetry to the shown children\n"
+			<< "symmetrize                     add the images of the shown children under every symmetry\n"
+			<< "merge                          remove duplicate children\n"
+			<< "validate | count               print the validation report or the number of children\n"
+			<< "memory                         print the bytes used by the model, by subsystem\n"
+			<< "load|save|export <file>        load, save or export the scheme\n"
+			<< "# ...                          comment" << std::endl;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include <RSE/ConsoleSidebarItem.hpp>
+
+#include <cinolib/gl/file_dialog_open.h>
+#include <imgui.h>
+#include <sstream>
+#include <exception>
+#include <chrono>
+
+namespace RSE
+{
+
+	ConsoleSidebarItem::ConsoleSidebarItem(AppSidebarItem& _app) : cinolib::SideBarItem{ "Console" }, m_app{ _app }, m_commands{ _app }, onRun{}, onRunFile{}
+	{}
+
+	void ConsoleSidebarItem::print(const std::string& _text)
+	{
+		std::istringstream stream{ _text };
+		std::string line{};
+		while (std::getline(stream, line))
+		{
+			m_lines.push_back(line);
+		}
+		if (m_lines.size() > c_maxLines)
+		{
+			m_lines.erase(m_lines.begin(), m_lines.end() - c_maxLines);
+		}
+	}
+
+	void ConsoleSidebarItem::run(const std::string& _line)
+	{
+		onRun(_line);
+		print("> " + _line);
+		std::ostringstream output{};
+		try
+		{
+			m_commands.run(_line, output);
+		}
+		catch (const std::exception& _exception)
+		{
+			output << "error: " << _exception.what() << '\n';
+		}
+		print(output.str());
+	}
+
+	void ConsoleSidebarItem::runFile(const std::string& _filename)
+	{
+		onRunFile(_filename);
+		std::ostringstream output{};
+		try
+		{
+			const auto start{ std::chrono::steady_clock::now() };
+			const std::size_t count{ m_commands.runFile(_filename, output) };
+			output << "Ran " << count << " lines in " << std::chrono::duration<Real>{ std::chrono::steady_clock::now() - start }.count() << "s\n";
+		}
+		catch (const std::exception& _exception)
+		{
+			output << "error: " << _exception.what() << '\n';
+		}
+		print(output.str());
+	}
+
+	void ConsoleSidebarItem::runFile()
+	{
+		const std::string filename{ cinolib::file_dialog_open() };
+		if (!filename.empty())
+		{
+			runFile(filename);
+		}
+	}
+
+	void ConsoleSidebarItem::draw()
+	{
+		if (m_app.loading())
+		{
+			ImGui::TextDisabled("Loading...");
+			return;
+		}
+		if (ImGui::Button("Run script"))
+		{
+			runFile();
+		}
+		ImGui::SameLine();
+		if (ImGui::Button("Help"))
+		{
+			std::ostringstream help{};
+			Commands::printHelp(help);
+			print(help.str());
+		}
+		ImGui::SameLine();
+		if (ImGui::Button("Clear"))
+		{
+			m_lines.clear();
+		}
+		ImGui::BeginChild("output", ImVec2{ 0.0f, ImGui::GetTextLineHeightWithSpacing() * 12.0f }, true, ImGuiWindowFlags_HorizontalScrollbar);
+		for (const std::string& line : m_lines)
+		{
+			ImGui::TextUnformatted(line.c_str());
+		}
+		if (ImGui::GetScrollY() >= ImGui::GetScrollMaxY())
+		{
+			ImGui::SetScrollHereY(1.0f);
+		}
+		ImGui::EndChild();
+		ImGui::SetNextItemWidth(-1.0f);
+		if (ImGui::InputText("##command", m_input.data(), m_input.size(), ImGuiInputTextFlags_EnterReturnsTrue))
+		{
+			run(m_input.data());
+			m_input[0] = '\0';
+			ImGui::SetKeyboardFocusHere(-1);
+		}
+	}
+
+}
\ No newline at end of file
@@ -1,9 +1,24 @@
 #include <RSE/CppExporter.hpp>
 
+#include <RSE/FaceIndex.hpp>
+#include <RSE/hexUtils.hpp>
+#include <RSE/schemeIO.hpp>
+#include <RSE/symmetry.hpp>
+#include <RSE/parallel.hpp>
 #include <sstream>
 #include <utility>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <cctype>
+#include <fstream>
+#include <iomanip>
+#include <exception>
+#include <stdexcept>
+#include <string_view>
 
 namespace RSE
 {
@@ -13,23 +28,52 @@ namespace RSE
 		Int size{};
 		std::vector<IVec3> verts{};
 		std::vector<std::array<Int, 8>> polys{};
+		std::vector<std::array<Int, 4>> faces{};
+		std::vector<std::array<Int, 6>> polyFaces{};
+		std::vector<std::array<Int, 2>> edges{};
+		std::vector<std::array<Int, 12>> polyEdges{};
 	};
 
-	struct VertHasher final
-	{
+	using VertMap = std::unordered_map<IVec3, Int, hexUtils::VertsHasher>;
 
-		size_t operator()(const IVec3& _vec) const
+	// adds the vertices of _children missing from the pool
+	void addToPool(VertMap& _map, std::vector<IVec3>& _verts, const std::vector<HexVertsU>& _children)
+	{
+		for (const HexVertsU& child : _children)
 		{
-			return _vec.x() * 100 + _vec.y() * 10 + _vec.z();
+			for (const IVec3& vert : child)
+			{
+				if (_map.emplace(vert, static_cast<Int>(_verts.size())).second)
+				{
+					_verts.push_back(vert);
+				}
+			}
 		}
+	}
 
-	};
+	// polys indexed into a shared pool, which must contain every vertex; data.verts is left empty
+	ExportData prepare(Int _size, const std::vector<HexVertsU>& _children, const VertMap& _pool)
+	{
+		ExportData data{};
+		data.size = _size;
+		data.polys.reserve(_children.size());
+		for (const HexVertsU& child : _children)
+		{
+			std::array<Int, 8> mappedChild;
+			for (std::size_t i{}; i < 8; i++)
+			{
+				mappedChild[i] = _pool.at(child[i]);
+			}
+			data.polys.push_back(mappedChild);
+		}
+		return data;
+	}
 
 	ExportData prepare(Int _size, const std::vector<HexVertsU>& _children)
 	{
 		ExportData data{};
 		data.size = _size;
-		std::unordered_map<IVec3, Int, VertHasher> vertMap{};
+		VertMap vertMap{};
 		for (const HexVertsU& child : _children)
 		{
 			std::array<Int, 8> mappedChild;
@@ -53,35 +97,427 @@ namespace RSE
 		return data;
 	}
 
-	std::string CppExporter::operator()(Int _size, const std::vector<HexVertsU>& _children) const
+	// faces and edges are listed per poly in hexUtils::hexFaceInds and hexUtils::hexEdgeInds order (see orderComment);
+	// each face keeps the winding it has in the first poly that uses it
+	void prepareFaces(ExportData& _data, const std::vector<HexVertsU>& _children)
 	{
-		const ExportData data{ prepare(_size, _children) };
+		const FaceIndex index{ _children };
+		_data.faces.reserve(index.faces().size());
+		_data.polyFaces.assign(_children.size(), {});
+		std::vector<std::array<bool, 6>> assigned(_children.size(), std::array<bool, 6>{});
+		for (std::size_t p{}; p < _children.size(); p++)
+		{
+			for (std::size_t f{}; f < 6; f++)
+			{
+				if (!assigned[p][f])
+				{
+					const Int face{ static_cast<Int>(_data.faces.size()) };
+					std::array<Int, 4> verts;
+					for (std::size_t i{}; i < 4; i++)
+					{
+						verts[i] = _data.polys[p][hexUtils::hexFaceInds[f][i]];
+					}
+					_data.faces.push_back(verts);
+					for (const FaceIndex::FaceRef& ref : index.refs(hexUtils::faceVerts(_children[p], f)))
+					{
+						const std::size_t other{ index.index(ref.hex) };
+						_data.polyFaces[other][ref.face] = face;
+						assigned[other][ref.face] = true;
+					}
+				}
+			}
+		}
+	}
+
+	void prepareEdges(ExportData& _data)
+	{
+		std::unordered_map<std::uint64_t, Int> edgeMap{};
+		edgeMap.reserve(_data.polys.size() * 4);
+		_data.polyEdges.reserve(_data.polys.size());
+		for (const std::array<Int, 8>& poly : _data.polys)
+		{
+			std::array<Int, 12> polyEdges;
+			for (std::size_t e{}; e < 12; e++)
+			{
+				const Int a{ poly[hexUtils::hexEdgeInds[e][0]] }, b{ poly[hexUtils::hexEdgeInds[e][1]] };
+				const std::array<Int, 2> edge{ std::min(a, b), std::max(a, b) };
+				const std::uint64_t key{ static_cast<std::uint64_t>(edge[0]) << 32 | static_cast<std::uint32_t>(edge[1]) };
+				const auto [it, inserted] { edgeMap.emplace(key, static_cast<Int>(_data.edges.size())) };
+				if (inserted)
+				{
+					_data.edges.push_back(edge);
+				}
+				polyEdges[e] = it->second;
+			}
+			_data.polyEdges.push_back(polyEdges);
+		}
+	}
+
+	template<std::size_t TSize>
+	void writeIndsList(std::ostringstream& _ss, const std::string& _listType, const std::string& _type, const std::vector<std::array<Int, TSize>>& _list)
+	{
+		_ss << ",\n";
+		_ss << "\t" << _listType << "{\n";
+		for (const std::array<Int, TSize>& inds : _list)
+		{
+			_ss << "\t\t" << _type << "{";
+			for (const Int index : inds)
+			{
+				_ss << index << ", ";
+			}
+			_ss << "},\n";
+		}
+		_ss << "\t}";
+	}
+
+	// FNV-1a, continuing from _hash
+	void fnv1a(std::uint64_t& _hash, std::string_view _data)
+	{
+		for (const char c : _data)
+		{
+			_hash = (_hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+		}
+	}
+
+	constexpr std::uint64_t c_hashSeed{ 14695981039346656037ull };
+
+	// every setting that affects the output
+	std::string settingsKey(const CppExporter& _exporter)
+	{
+		std::ostringstream ss{};
+		ss << _exporter.constant << _exporter.faces << _exporter.edges;
+		for (const std::size_t index : _exporter.polyIndices)
+		{
+			ss << index;
+		}
+		for (const std::string* field : {
+			&_exporter.name, &_exporter.indsType, &_exporter.indsListType, &_exporter.vertType, &_exporter.vertListType, &_exporter.type,
+			&_exporter.faceIndsType, &_exporter.faceIndsListType, &_exporter.polyFacesType, &_exporter.polyFacesListType,
+			&_exporter.edgeIndsType, &_exporter.edgeIndsListType, &_exporter.polyEdgesType, &_exporter.polyEdgesListType })
+		{
+			ss << '\0' << *field;
+		}
+		return ss.str();
+	}
+
+	void writeVerts(std::ostringstream& _ss, const CppExporter& _exporter, const std::vector<IVec3>& _verts)
+	{
+		_ss << "\t" << _exporter.vertListType << "{\n";
+		for (const IVec3& vert : _verts)
+		{
+			_ss << "\t\t" << _exporter.vertType << "{" << vert.x() << ", " << vert.y() << ", " << vert.z() << "},\n";
+		}
+		_ss << "\t}";
+	}
+
+	// the per-poly face and edge order, as positions in the written polys (that is, after polyIndices);
+	// empty if neither faces nor edges are exported
+	std::string orderComment(const CppExporter& _exporter)
+	{
+		if (!_exporter.faces && !_exporter.edges)
+		{
+			return "";
+		}
+		std::array<std::size_t, 8> positions;
+		std::array<bool, 8> found{};
+		for (std::size_t i{}; i < 8; i++)
+		{
+			const std::size_t index{ _exporter.polyIndices[i] };
+			if (index >= 8 || found[index])
+			{
+				throw std::logic_error{ "polyIndices is not a permutation" };
+			}
+			found[index] = true;
+			positions[index] = i;
+		}
 		std::ostringstream ss{};
-		if (constant)
+		const auto writeOrder{ [&](const std::string& _what, const auto& _inds) {
+			ss << "// " << _what << " of each " << _exporter.indsType << ", as positions in it:";
+			for (const auto& element : _inds)
+			{
+				ss << " {";
+				for (std::size_t i{}; i < element.size(); i++)
+				{
+					ss << (i ? ", " : "") << positions[element[i]];
+				}
+				ss << "}";
+			}
+			ss << "\n";
+		} };
+		if (_exporter.faces)
+		{
+			writeOrder("faces", hexUtils::hexFaceInds);
+		}
+		if (_exporter.edges)
+		{
+			writeOrder("edges", hexUtils::hexEdgeInds);
+		}
+		return ss.str();
+	}
+
+	// _pool names a shared vertex list, otherwise the vertices are written inline
+	std::string formatDefinition(const CppExporter& _exporter, const std::string& _name, const ExportData& _data, const std::string& _pool)
+	{
+		std::ostringstream ss{};
+		if (_exporter.constant)
 		{
 			ss << "const ";
 		}
-		ss << type << " " << name << " {\n";
-		ss << "\t" << _size << ",\n";
-		ss << "\t" << vertListType << "{\n";
-		for (const IVec3& vert : data.verts)
+		ss << _exporter.type << " " << _name << " {\n";
+		ss << "\t" << _data.size << ",\n";
+		if (_pool.empty())
+		{
+			writeVerts(ss, _exporter, _data.verts);
+		}
+		else
 		{
-			ss << "\t\t" << vertType << "{" << vert.x() << ", " << vert.y() << ", " << vert.z() << "},\n";
+			ss << "\t" << _pool;
 		}
-		ss << "\t},\n";
-		ss << "\t" << indsListType << "{\n";
-		for (const std::array<Int, 8>&poly : data.polys)
+		ss << ",\n";
+		ss << "\t" << _exporter.indsListType << "{\n";
+		for (const std::array<Int, 8>&poly : _data.polys)
 		{
-			ss << "\t\t" << indsType << "{";
-			for (const std::size_t index : polyIndices)
+			ss << "\t\t" << _exporter.indsType << "{";
+			for (const std::size_t index : _exporter.polyIndices)
 			{
 				ss << poly[index] << ", ";
 			}
 			ss << "},\n";
 		}
-		ss << "\t}\n";
+		ss << "\t}";
+		if (_exporter.faces)
+		{
+			writeIndsList(ss, _exporter.faceIndsListType, _exporter.faceIndsType, _data.faces);
+			writeIndsList(ss, _exporter.polyFacesListType, _exporter.polyFacesType, _data.polyFaces);
+		}
+		if (_exporter.edges)
+		{
+			writeIndsList(ss, _exporter.edgeIndsListType, _exporter.edgeIndsType, _data.edges);
+			writeIndsList(ss, _exporter.polyEdgesListType, _exporter.polyEdgesType, _data.polyEdges);
+		}
+		ss << "\n";
 		ss << "};";
 		return ss.str();
 	}
 
+	void prepareExtras(const CppExporter& _exporter, ExportData& _data, const std::vector<HexVertsU>& _children)
+	{
+		if (_exporter.faces)
+		{
+			prepareFaces(_data, _children);
+		}
+		if (_exporter.edges)
+		{
+			prepareEdges(_data);
+		}
+	}
+
+	// _base, or _base with the first free _<n> suffix, marked as taken
+	std::string uniqueName(std::unordered_set<std::string>& _taken, const std::string& _base)
+	{
+		std::string name{ _base };
+		for (std::size_t n{ 1 }; !_taken.insert(name).second; n++)
+		{
+			name = _base + "_" + std::to_string(n);
+		}
+		return name;
+	}
+
+	std::string CppExporter::identifier(const std::string& _filename)
+	{
+		std::string name{ _filename.substr(_filename.find_last_of("/\\") + 1) };
+		name = name.substr(0, name.find_last_of("."));
+		if (!name.empty() && std::isdigit(static_cast<unsigned char>(name[0])))
+		{
+			name[0] = '_';
+		}
+		for (char& c : name)
+		{
+			if (!(std::isalnum(static_cast<unsigned char>(c)) || c == '_'))
+			{
+				c = '_';
+			}
+		}
+		return name;
+	}
+
+	std::string CppExporter::operator()(Int _size, const std::vector<HexVertsU>& _children) const
+	{
+		ExportData data{ prepare(_size, _children) };
+		prepareExtras(*this, data, _children);
+		return orderComment(*this) + formatDefinition(*this, name, data, "");
+	}
+
+	std::string CppExporter::operator()(const std::vector<Source>& _sources) const
+	{
+		// names
+		std::unordered_set<std::string> taken{};
+		std::vector<std::string> names(_sources.size());
+		for (std::size_t s{}; s < _sources.size(); s++)
+		{
+			names[s] = uniqueName(taken, _sources[s].name);
+		}
+		// pools
+		std::map<Int, std::vector<std::size_t>> sizes{};
+		for (std::size_t s{}; s < _sources.size(); s++)
+		{
+			sizes[_sources[s].size].push_back(s);
+		}
+		struct Pool final
+		{
+			Int size;
+			std::string name;
+			VertMap map;
+			std::vector<IVec3> verts;
+			std::string code;
+		};
+		std::vector<Pool> pools{};
+		std::vector<std::size_t> sourcePools(_sources.size());
+		for (const auto& [size, sources] : sizes)
+		{
+			for (const std::size_t source : sources)
+			{
+				sourcePools[source] = pools.size();
+			}
+			pools.push_back(Pool{ .size = size, .name = uniqueName(taken, name + "Verts" + std::to_string(size)) });
+		}
+		parallel::forEach(pools.size(), [&](std::size_t _p) {
+			Pool& pool{ pools[_p] };
+			for (const std::size_t source : sizes.at(pool.size))
+			{
+				addToPool(pool.map, pool.verts, _sources[source].children);
+			}
+			std::ostringstream ss{};
+			ss << "inline " << (constant ? "const " : "") << vertListType << " " << pool.name << "{\n";
+			for (const IVec3& vert : pool.verts)
+			{
+				ss << "\t" << vertType << "{" << vert.x() << ", " << vert.y() << ", " << vert.z() << "},\n";
+			}
+			ss << "};";
+			pool.code = ss.str();
+		});
+		// definitions
+		std::vector<std::string> definitions(_sources.size());
+		parallel::forEach(_sources.size(), [&](std::size_t _s) {
+			const Source& source{ _sources[_s] };
+			ExportData data{ prepare(source.size, source.children, pools[sourcePools[_s]].map) };
+			prepareExtras(*this, data, source.children);
+			definitions[_s] = "inline " + formatDefinition(*this, names[_s], data, pools[sourcePools[_s]].name);
+		});
+		std::string code{ "#pragma once\n" };
+		const std::string order{ orderComment(*this) };
+		if (!order.empty())
+		{
+			code += "\n" + order;
+		}
+		for (const Pool& pool : pools)
+		{
+			code += "\n" + pool.code + "\n";
+		}
+		for (const std::string& definition : definitions)
+		{
+			code += "\n" + definition + "\n";
+		}
+		return code;
+	}
+
+	bool CppExporter::exportFiles(const std::vector<std::string>& _files, const std::string& _output) const
+	{
+		// inputs
+		std::vector<std::string> contents(_files.size());
+		std::vector<std::exception_ptr> errors(_files.size());
+		parallel::forEach(_files.size(), [&](std::size_t _f) {
+			std::ifstream file{ _files[_f], std::ios::binary };
+			if (!file)
+			{
+				errors[_f] = std::make_exception_ptr(std::runtime_error{ "cannot open '" + _files[_f] + "'" });
+				return;
+			}
+			std::ostringstream content{};
+			content << file.rdbuf();
+			contents[_f] = content.str();
+		});
+		for (const std::exception_ptr& error : errors)
+		{
+			if (error)
+			{
+				std::rethrow_exception(error);
+			}
+		}
+		std::uint64_t inputsHash{ c_hashSeed };
+		fnv1a(inputsHash, settingsKey(*this));
+		for (std::size_t f{}; f < _files.size(); f++)
+		{
+			fnv1a(inputsHash, std::string_view{ "\0", 1 });
+			fnv1a(inputsHash, identifier(_files[f]));
+			fnv1a(inputsHash, std::string_view{ "\0", 1 });
+			fnv1a(inputsHash, contents[f]);
+		}
+		std::string existingInputsHash{}, existingContentHash{};
+		{
+			std::ifstream existing{ _output };
+			std::string comment{}, tag{};
+			existing >> comment >> tag >> existingInputsHash >> existingContentHash;
+			if (!existing || comment != "//" || tag != "rse-export")
+			{
+				existingInputsHash = existingContentHash = "";
+			}
+		}
+		const auto hex{ [](std::uint64_t _hash) {
+			std::ostringstream ss{};
+			ss << std::hex << std::setw(16) << std::setfill('0') << _hash;
+			return ss.str();
+		} };
+		if (existingInputsHash == hex(inputsHash))
+		{
+			return false;
+		}
+		// schemes
+		std::vector<Source> sources(_files.size());
+		parallel::forEach(_files.size(), [&](std::size_t _f) {
+			try
+			{
+				std::istringstream content{ contents[_f] };
+				schemeIO::Scheme scheme{ schemeIO::read(content) };
+				const std::vector<std::size_t> duplicates{ symmetry::duplicates(scheme.children) };
+				std::size_t kept{};
+				for (std::size_t i{}, d{}; i < scheme.children.size(); i++)
+				{
+					if (d < duplicates.size() && duplicates[d] == i)
+					{
+						d++;
+					}
+					else
+					{
+						scheme.children[kept++] = scheme.children[i];
+					}
+				}
+				scheme.children.resize(kept);
+				sources[_f] = Source{ .name = identifier(_files[_f]), .size = scheme.size, .children = std::move(scheme.children) };
+			}
+			catch (...)
+			{
+				errors[_f] = std::current_exception();
+			}
+		});
+		for (const std::exception_ptr& error : errors)
+		{
+			if (error)
+			{
+				std::rethrow_exception(error);
+			}
+		}
+		const std::string code{ (*this)(sources) };
+		std::uint64_t contentHash{ c_hashSeed };
+		fnv1a(contentHash, code);
+		if (existingContentHash == hex(contentHash))
+		{
+			return false;
+		}
+		schemeIO::writeAtomic(_output, [&](std::ostream& _stream) {
+			_stream << "// rse-export " << hex(inputsHash) << ' ' << hex(contentHash) << '\n' << code;
+		});
+		return true;
+	}
+
 }
\ No newline at end of file
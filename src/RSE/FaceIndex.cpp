@@ -0,0 +1,220 @@
+#include <RSE/FaceIndex.hpp>
+
+#include <RSE/hexUtils.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace RSE
+{
+
+	QuadVertsU FaceIndex::key(const QuadVertsU& _face)
+	{
+		QuadVertsU key{ _face };
+		std::sort(key.begin(), key.end(), [](const IVec3& _a, const IVec3& _b) {
+			return std::lexicographical_compare(_a.ptr(), _a.ptr() + 3, _b.ptr(), _b.ptr() + 3);
+		});
+		return key;
+	}
+
+	QuadVertsU FaceIndex::key(const HexVertsU& _hex, std::size_t _face)
+	{
+		return key(hexUtils::faceVerts(_hex, _face));
+	}
+
+	FaceIndex::FaceIndex() : m_faces{}, m_hexes{}, m_ids{}, m_indices{}, m_freeIds{}
+	{}
+
+	FaceIndex::FaceIndex(const std::vector<HexVertsU>& _hexes) : m_faces{}, m_hexes{ &_hexes }, m_ids(_hexes.size()), m_indices(_hexes.size()), m_freeIds{}
+	{
+		m_faces.reserve(_hexes.size() * 4);
+		for (std::size_t i{}; i < _hexes.size(); i++)
+		{
+			m_ids[i] = m_indices[i] = i;
+			insert(i, _hexes[i]);
+		}
+	}
+
+	void FaceIndex::rebind(const std::vector<HexVertsU>& _hexes)
+	{
+		m_hexes = &_hexes;
+	}
+
+	void FaceIndex::insert(std::size_t _id, const HexVertsU& _verts)
+	{
+		for (std::size_t f{}; f < 6; f++)
+		{
+			m_faces[key(_verts, f)].push_back(FaceRef{ _id, f });
+		}
+	}
+
+	void FaceIndex::erase(std::size_t _id, const HexVertsU& _verts, std::vector<std::size_t>& _touched)
+	{
+		for (std::size_t f{}; f < 6; f++)
+		{
+			const auto it{ m_faces.find(key(_verts, f)) };
+			std::vector<FaceRef>& refs{ it->second };
+			refs.erase(std::remove_if(refs.begin(), refs.end(), [_id, f](const FaceRef& _ref) { return _ref.hex == _id && _ref.face == f; }), refs.end());
+			for (const FaceRef& ref : refs)
+			{
+				if (ref.hex != _id)
+				{
+					_touched.push_back(ref.hex);
+				}
+			}
+			if (refs.empty())
+			{
+				m_faces.erase(it);
+			}
+		}
+	}
+
+	std::vector<std::size_t> FaceIndex::touchedIndices(std::vector<std::size_t>& _touched) const
+	{
+		for (std::size_t& hex : _touched)
+		{
+			hex = m_indices[hex];
+		}
+		std::sort(_touched.begin(), _touched.end());
+		_touched.erase(std::unique(_touched.begin(), _touched.end()), _touched.end());
+		return std::move(_touched);
+	}
+
+	std::size_t FaceIndex::size() const
+	{
+		return m_ids.size();
+	}
+
+	std::size_t FaceIndex::bytes() const
+	{
+		std::size_t bytes{ (m_ids.capacity() + m_indices.capacity() + m_freeIds.capacity()) * sizeof(std::size_t) + m_faces.bucket_count() * sizeof(void*) };
+		for (const auto& [face, refs] : m_faces)
+		{
+			// next pointer and cached hash
+			bytes += sizeof(Faces::value_type) + 2 * sizeof(void*) + refs.capacity() * sizeof(FaceRef);
+		}
+		return bytes;
+	}
+
+	const HexVertsU& FaceIndex::hex(std::size_t _hex) const
+	{
+		return (*m_hexes)[_hex];
+	}
+
+	std::size_t FaceIndex::index(std::size_t _id) const
+	{
+		return m_indices[_id];
+	}
+
+	const FaceIndex::Faces& FaceIndex::faces() const
+	{
+		return m_faces;
+	}
+
+	void FaceIndex::add()
+	{
+		if (m_ids.size() >= m_hexes->size())
+		{
+			throw std::logic_error{ "no hex to add" };
+		}
+		std::size_t id;
+		if (m_freeIds.empty())
+		{
+			id = m_indices.size();
+			m_indices.push_back(m_ids.size());
+		}
+		else
+		{
+			id = m_freeIds.back();
+			m_freeIds.pop_back();
+			m_indices[id] = m_ids.size();
+		}
+		m_ids.push_back(id);
+		insert(id, (*m_hexes)[m_ids.size() - 1]);
+	}
+
+	std::vector<std::size_t> FaceIndex::update(std::size_t _hex, const HexVertsU& _oldVerts)
+	{
+		if (_hex >= m_ids.size())
+		{
+			throw std::logic_error{ "index out of bounds" };
+		}
+		const std::size_t id{ m_ids[_hex] };
+		const HexVertsU& verts{ (*m_hexes)[_hex] };
+		std::vector<std::size_t> touched{};
+		if (verts != _oldVerts)
+		{
+			erase(id, _oldVerts, touched);
+			insert(id, verts);
+			for (std::size_t f{}; f < 6; f++)
+			{
+				for (const FaceRef& ref : m_faces[key(verts, f)])
+				{
+					if (ref.hex != id)
+					{
+						touched.push_back(ref.hex);
+					}
+				}
+			}
+		}
+		return touchedIndices(touched);
+	}
+
+	std::vector<std::size_t> FaceIndex::remove(std::size_t _hex, const HexVertsU& _oldVerts)
+	{
+		if (_hex >= m_ids.size())
+		{
+			throw std::logic_error{ "index out of bounds" };
+		}
+		const std::size_t id{ m_ids[_hex] };
+		std::vector<std::size_t> touched{};
+		erase(id, _oldVerts, touched);
+		// only the id <-> index maps shift, the face refs keep their ids
+		m_ids.erase(m_ids.begin() + static_cast<std::ptrdiff_t>(_hex));
+		for (std::size_t i{ _hex }; i < m_ids.size(); i++)
+		{
+			m_indices[m_ids[i]] = i;
+		}
+		m_freeIds.push_back(id);
+		return touchedIndices(touched);
+	}
+
+	void FaceIndex::clear()
+	{
+		m_faces.clear();
+		m_ids.clear();
+		m_indices.clear();
+		m_freeIds.clear();
+	}
+
+	const std::vector<FaceIndex::FaceRef>& FaceIndex::refs(const QuadVertsU& _face) const
+	{
+		static const std::vector<FaceRef> empty{};
+		const auto it{ m_faces.find(key(_face)) };
+		return it != m_faces.end() ? it->second : empty;
+	}
+
+	std::optional<std::size_t> FaceIndex::neighbor(std::size_t _hex, std::size_t _face) const
+	{
+		const std::size_t id{ m_ids[_hex] };
+		for (const FaceRef& ref : m_faces.at(key((*m_hexes)[_hex], _face)))
+		{
+			if (ref.hex != id)
+			{
+				return m_indices[ref.hex];
+			}
+		}
+		return std::nullopt;
+	}
+
+	std::array<std::optional<std::size_t>, 6> FaceIndex::neighbors(std::size_t _hex) const
+	{
+		std::array<std::optional<std::size_t>, 6> neighbors;
+		for (std::size_t f{}; f < 6; f++)
+		{
+			neighbors[f] = neighbor(_hex, f);
+		}
+		return neighbors;
+	}
+
+}
\ No newline at end of file
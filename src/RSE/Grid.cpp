@@ -2,97 +2,140 @@
 
 #include <utility>
 #include <cmath>
-#include <cinolib/geometry/lerp.hpp>
+#include <cassert>
+#include <limits>
+#include <stdexcept>
+#include <algorithm>
+#include <RSE/WeightTable.hpp>
 
 namespace RSE
 {
 
-	template<typename TOut, typename TIn, std::size_t TSize>
-	typename std::conditional_t<std::is_same_v<TIn, TOut>, const std::array<Vec3<TOut>, TSize>&, std::array<Vec3<TOut>, TSize>> genCast(const std::array<Vec3<TIn>, TSize>& _vecs)
+	namespace
 	{
-		if constexpr (std::is_same_v<TIn, TOut>)
+
+		template<typename TValue>
+		TValue pointLineOffset(const Vec3<TValue>& _origin, const Vec3<TValue>& _dir, const Vec3<TValue>& _point)
 		{
-			return _vecs;
+			const Vec3<TValue> ab = _dir;
+			const Vec3<TValue> ap = _point - _origin;
+
+			if (ap.dot(ab) <= TValue{ 0 })
+				return static_cast<TValue>(-ap.norm());
+
+			const Vec3<TValue> bp = _point - (_origin + _dir);
+
+			if (bp.dot(ab) >= TValue{ 0 })
+				return static_cast<TValue>(bp.norm());
+
+			return static_cast<TValue>((ab.cross(ap)).norm() / ab.norm());
 		}
-		else
+
+		template<typename TValue>
+		TValue pointLineSqrDist(const Vec3<TValue>& _origin, const Vec3<TValue>& _normDir, const Vec3<TValue>& _point, bool& _behind)
 		{
-			std::array<Vec3<TOut>, TSize> out;
-			for (std::size_t i{}; i < _vecs.size(); i++)
-			{
-				out[i] = _vecs[i].template cast<TOut>();
-			}
-			return out;
+			const TValue offset{ pointLineOffset(_origin, _normDir, _point) };
+			_behind = offset < 0;
+			return _point.dist_sqrd(_origin + _normDir * offset);
 		}
+
 	}
 
-	template<typename TOut, typename TIn>
-	typename std::conditional_t<std::is_same_v<TIn, TOut>, const std::vector<Vec3<TOut>>&, std::vector<Vec3<TOut>>> genCast(const std::vector<Vec3<TIn>>& _vecs)
+	Grid::RealPoints::RealPoints(const Grid& _grid) : m_grid{ _grid }
+	{}
+
+	std::size_t Grid::RealPoints::size() const
 	{
-		if constexpr (std::is_same_v<TIn, TOut>)
-		{
-			return _vecs;
-		}
-		else
-		{
-			std::vector<Vec3<TOut>> out;
-			out.resize(_vecs.size());
-			for (std::size_t i{}; i < _vecs.size(); i++)
-			{
-				out[i] = _vecs[i].template cast<TOut>();
-			}
-			return out;
-		}
+		const Int layers{ m_grid.m_size + 1 };
+		return static_cast<std::size_t>(layers * layers * layers);
 	}
 
-	typename Grid::CastResult<Grid::FastVert> Grid::cast(const RVec3& _vec)
+	RVec3 Grid::RealPoints::operator[](std::size_t _index) const
 	{
-		return _vec.cast<FastValue>();
+		return m_grid.point(_index);
 	}
 
-	typename Grid::CastResult<Grid::FastVert> Grid::cast(const IVec3& _vec)
+	template<>
+	const Grid::Points<float>& Grid::points<float>() const
 	{
-		return _vec.cast<FastValue>();
+		return m_singlePoints;
 	}
 
-	typename Grid::CastResult<RVec3> Grid::cast(const FastVert& _vec)
+	template<>
+	const Grid::Points<Real>& Grid::points<Real>() const
 	{
-		return _vec.cast<Real>();
+		return m_doublePoints;
 	}
 
-	typename Grid::CastResult<Grid::FastHex> Grid::cast(const HexVerts& _verts)
+	template<typename TValue>
+	void Grid::make(Int _size, const HexVerts& _verts, Points<TValue>& _points)
 	{
-		return genCast<FastValue>(_verts);
+		HexVertData<Vec3<TValue>> sourceHex;
+		for (std::size_t i{}; i < 8; i++)
+		{
+			sourceHex[i] = _verts[i].template cast<TValue>();
+		}
+		const Int layers{ _size + 1 };
+		for (std::vector<TValue>& dim : _points)
+		{
+			dim.resize(static_cast<std::size_t>(layers * layers * layers));
+		}
+		WeightTable<TValue>::lattice(_size)->apply(sourceHex, _points[0].data(), _points[1].data(), _points[2].data());
 	}
 
-	typename Grid::FastValue Grid::pointLineOffset(const FastVert& _origin, const FastVert& _dir, const FastVert& _point)
+	Real Grid::precisionDeviation(Int _size, const HexVerts& _verts)
 	{
-		const FastVert ab = _dir;
-		const FastVert ap = _point - _origin;
-
-		if (ap.dot(ab) <= FastValue{ 0 })
-			return static_cast<FastValue>(- ap.norm());
-
-		const FastVert bp = _point - (_origin + _dir);
+		Points<float> singlePoints;
+		Points<Real> doublePoints;
+		make(_size, _verts, singlePoints);
+		make(_size, _verts, doublePoints);
+		Real maxSqrDist{};
+		for (std::size_t i{}; i < doublePoints[0].size(); i++)
+		{
+			Real sqrDist{};
+			for (std::size_t d{}; d < 3; d++)
+			{
+				const Real diff{ static_cast<Real>(singlePoints[d][i]) - doublePoints[d][i] };
+				sqrDist += diff * diff;
+			}
+			maxSqrDist = std::max(maxSqrDist, sqrDist);
+		}
+		return std::sqrt(maxSqrDist);
+	}
 
-		if (bp.dot(ab) >= FastValue{ 0 })
-			return static_cast<FastValue>(bp.norm());
+	Grid::Grid() : m_precision{ EPrecision::Single }, m_singlePoints{}, m_doublePoints{}, m_verts{}, m_size{ 0 }
+	{}
 
-		return static_cast<FastValue>((ab.cross(ap)).norm() / ab.norm());
+	Int Grid::size() const
+	{
+		return m_size;
 	}
 
-	typename Grid::FastValue Grid::pointLineSqrDist(const FastVert& _origin, const FastVert& _normDir, const FastVert& _point, bool& _behind)
+	Grid::EPrecision Grid::precision() const
 	{
-		const FastValue offset{ pointLineOffset(_origin, _normDir, _point) };
-		_behind = offset < 0;
-		return _point.dist_sqrd(_origin + _normDir * offset);
+		return m_precision;
 	}
 
-	Grid::Grid() : m_size{ 0 }, m_points{}
-	{}
+	std::size_t Grid::bytes() const
+	{
+		std::size_t bytes{};
+		for (std::size_t d{}; d < 3; d++)
+		{
+			bytes += m_singlePoints[d].capacity() * sizeof(float) + m_doublePoints[d].capacity() * sizeof(Real);
+		}
+		return bytes;
+	}
 
-	Int Grid::size() const
+	void Grid::setPrecision(EPrecision _precision)
 	{
-		return m_size;
+		if (m_precision != _precision)
+		{
+			m_precision = _precision;
+			if (m_size)
+			{
+				make(m_size, m_verts);
+			}
+		}
 	}
 
 	void Grid::make(Int _size, const HexVerts& _verts)
@@ -102,34 +145,27 @@ namespace RSE
 			throw std::logic_error{ "size must be positive" };
 		}
 		m_size = _size;
-		const FastHex sourceHex{ cast(_verts) };
-		const Int layers{ _size + 1 };
-		m_points.resize(static_cast<std::size_t>(layers * layers * layers));
-		std::size_t i{};
-		IVec3 coord;
-		for (Int z{}; z < layers; z++)
+		m_verts = _verts;
+		if (m_precision == EPrecision::Single)
 		{
-			coord.z() = z;
-			for (Int y{}; y < layers; y++)
-			{
-				coord.y() = y;
-				for (Int x{}; x < layers; x++)
-				{
-					coord.x() = x;
-					m_points[i++] = cinolib::lerp3(sourceHex, cast(coord) / static_cast<FastValue>(_size));
-				}
-			}
+			make(_size, _verts, m_singlePoints);
+			m_doublePoints = {};
+		}
+		else
+		{
+			make(_size, _verts, m_doublePoints);
+			m_singlePoints = {};
 		}
 	}
 
-	const std::vector<Grid::FastVert>& Grid::points() const
+	Real Grid::precisionDeviation() const
 	{
-		return m_points;
+		return m_size ? precisionDeviation(m_size, m_verts) : 0;
 	}
 
-	typename Grid::CastResult<std::vector<RVec3>> Grid::realPoints() const
+	Grid::RealPoints Grid::realPoints() const
 	{
-		return genCast<Real>(m_points);
+		return RealPoints{ *this };
 	}
 
 	std::size_t Grid::index(const IVec3& _coords) const
@@ -143,7 +179,7 @@ namespace RSE
 
 	IVec3 Grid::coord(std::size_t _index) const
 	{
-		assert(_index <= m_points.size());
+		assert(_index <= realPoints().size());
 		Int index{ static_cast<Int>(_index) };
 		IVec3 coord;
 		const Int layers{ m_size + 1 };
@@ -167,8 +203,12 @@ namespace RSE
 
 	RVec3 Grid::point(std::size_t _index) const
 	{
-		assert(_index <= m_points.size());
-		return cast(m_points[_index]);
+		assert(_index <= realPoints().size());
+		if (m_precision == EPrecision::Single)
+		{
+			return RVec3{ m_singlePoints[0][_index], m_singlePoints[1][_index], m_singlePoints[2][_index] };
+		}
+		return RVec3{ m_doublePoints[0][_index], m_doublePoints[1][_index], m_doublePoints[2][_index] };
 	}
 
 	RVec3 Grid::point(const IVec3& _coords) const
@@ -183,9 +223,18 @@ namespace RSE
 
 	std::size_t Grid::closestToRay(const RVec3& _origin, const RVec3& _dir, const IVec3& _min, const IVec3& _max) const
 	{
-		FastValue minDist{ std::numeric_limits<FastValue>::infinity() };
+		return m_precision == EPrecision::Single
+			? closestToRay<float>(_origin, _dir, _min, _max)
+			: closestToRay<Real>(_origin, _dir, _min, _max);
+	}
+
+	template<typename TValue>
+	std::size_t Grid::closestToRay(const RVec3& _origin, const RVec3& _dir, const IVec3& _min, const IVec3& _max) const
+	{
+		const Points<TValue>& points{ this->points<TValue>() };
+		TValue minDist{ std::numeric_limits<TValue>::infinity() };
 		std::size_t minI{};
-		const FastVert& forigin{ cast(_origin) }, & fdir{ cast(_dir) };
+		const Vec3<TValue> origin{ _origin.template cast<TValue>() }, dir{ _dir.template cast<TValue>() };
 		IVec3 c;
 		for (Int x{ _min.x() }; x <= _max.x(); x++)
 		{
@@ -198,7 +247,7 @@ namespace RSE
 					c.z() = z;
 					const std::size_t i{ index(c) };
 					bool behind;
-					const FastValue dist{ pointLineSqrDist(forigin, fdir, m_points[i], behind) };
+					const TValue dist{ pointLineSqrDist(origin, dir, Vec3<TValue>{ points[0][i], points[1][i], points[2][i] }, behind) };
 					if (dist < minDist)
 					{
 						minDist = dist;
@@ -0,0 +1,117 @@
+#include <RSE/GridOverlay.hpp>
+
+#include <cinolib/gl/gl_glfw.h>
+#include <algorithm>
+
+namespace RSE
+{
+
+	std::size_t GridOverlay::segmentIndex(unsigned int _dim, Int _a, Int _b, Int _t) const
+	{
+		const std::size_t layers{ static_cast<std::size_t>(m_size + 1) };
+		return ((_dim * layers + static_cast<std::size_t>(_a)) * layers + static_cast<std::size_t>(_b)) * static_cast<std::size_t>(m_size) + static_cast<std::size_t>(_t);
+	}
+
+	void GridOverlay::make(const Grid& _grid)
+	{
+		m_size = _grid.size();
+		m_ranges.clear();
+		m_verts.resize(segmentIndex(3, 0, 0, 0) * 2 * 3);
+		RVec3 min{ _grid.point(IVec3{ 0,0,0 }) }, max{ min };
+		for (unsigned int d{}; d < 3; d++)
+		{
+			// segments along ds[0], one run per (ds[1], ds[2]) line
+			const unsigned int ds[3]{ d, (d + 1) % 3, (d + 2) % 3 };
+			IVec3 coord;
+			for (Int a{}; a <= m_size; a++)
+			{
+				coord[ds[1]] = a;
+				for (Int b{}; b <= m_size; b++)
+				{
+					coord[ds[2]] = b;
+					for (Int t{}; t < m_size; t++)
+					{
+						float* const out{ m_verts.data() + segmentIndex(d, a, b, t) * 2 * 3 };
+						for (Int e{}; e < 2; e++)
+						{
+							coord[ds[0]] = t + e;
+							const RVec3 point{ _grid.point(coord) };
+							for (unsigned int c{}; c < 3; c++)
+							{
+								out[e * 3 + c] = static_cast<float>(point[c]);
+								min[c] = std::min(min[c], point[c]);
+								max[c] = std::max(max[c], point[c]);
+							}
+						}
+					}
+				}
+			}
+		}
+		m_center = (min + max) / 2;
+		m_radius = static_cast<float>(min.dist(max) / 2);
+	}
+
+	void GridOverlay::setCursor(const IVec3& _min, const IVec3& _max)
+	{
+		m_ranges.clear();
+		for (unsigned int d{}; d < 3; d++)
+		{
+			const unsigned int ds[3]{ d, (d + 1) % 3, (d + 2) % 3 };
+			if (_max[ds[0]] == _min[ds[0]])
+			{
+				continue;
+			}
+			for (Int a{ _min[ds[1]] }; a <= _max[ds[1]]; a++)
+			{
+				for (Int b{ _min[ds[2]] }; b <= _max[ds[2]]; b++)
+				{
+					m_ranges.push_back(Range{
+						.first = static_cast<int>(segmentIndex(d, a, b, _min[ds[0]]) * 2),
+						.count = static_cast<int>((_max[ds[0]] - _min[ds[0]]) * 2)
+					});
+				}
+			}
+		}
+	}
+
+	std::size_t GridOverlay::bytes() const
+	{
+		return m_verts.capacity() * sizeof(float) + m_ranges.capacity() * sizeof(Range);
+	}
+
+	cinolib::ObjectType GridOverlay::object_type() const
+	{
+		return cinolib::DRAWABLE_SEGMENT_SOUP;
+	}
+
+	void GridOverlay::draw(const float _sceneSize) const
+	{
+		if (!visible || m_ranges.empty())
+		{
+			return;
+		}
+		glPushAttrib(GL_ENABLE_BIT | GL_LINE_BIT | GL_CURRENT_BIT);
+		glDisable(GL_LIGHTING);
+		glLineWidth(thickness);
+		glColor4f(color.r(), color.g(), color.b(), color.a());
+		glEnableClientState(GL_VERTEX_ARRAY);
+		glVertexPointer(3, GL_FLOAT, 0, m_verts.data());
+		for (const Range& range : m_ranges)
+		{
+			glDrawArrays(GL_LINES, range.first, range.count);
+		}
+		glDisableClientState(GL_VERTEX_ARRAY);
+		glPopAttrib();
+	}
+
+	cinolib::vec3d GridOverlay::scene_center() const
+	{
+		return m_center;
+	}
+
+	float GridOverlay::scene_radius() const
+	{
+		return m_radius;
+	}
+
+}
\ No newline at end of file
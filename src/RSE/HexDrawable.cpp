@@ -0,0 +1,241 @@
+#include <RSE/HexDrawable.hpp>
+
+#include <RSE/hexUtils.hpp>
+#include <cinolib/gl/gl_glfw.h>
+#include <algorithm>
+#include <cmath>
+
+namespace RSE
+{
+
+	const HexDrawable::Topology HexDrawable::topology{ [] {
+		Topology topology{};
+		for (std::size_t f{}; f < 6; f++)
+		{
+			for (std::size_t i{}; i < 4; i++)
+			{
+				topology.faces[f][i] = static_cast<unsigned char>(hexUtils::hexFaceInds[f][i]);
+			}
+		}
+		for (std::size_t e{}; e < 12; e++)
+		{
+			const EdgeVertData<std::size_t>& edge{ hexUtils::hexEdgeInds[e] };
+			topology.edges[e] = { static_cast<unsigned char>(edge[0]), static_cast<unsigned char>(edge[1]) };
+			std::size_t count{};
+			for (std::size_t f{}; f < 6; f++)
+			{
+				const QuadVertData<std::size_t>& face{ hexUtils::hexFaceInds[f] };
+				if (std::find(face.begin(), face.end(), edge[0]) != face.end() && std::find(face.begin(), face.end(), edge[1]) != face.end())
+				{
+					topology.edgeFaces[e][count++] = static_cast<unsigned char>(f);
+				}
+			}
+		}
+		// a distinct corner for each face
+		std::array<bool, 8> used{};
+		const auto assign{ [&](const auto& _self, std::size_t _face) -> bool {
+			if (_face == 6)
+			{
+				return true;
+			}
+			for (const unsigned char corner : topology.faces[_face])
+			{
+				if (!used[corner])
+				{
+					used[corner] = true;
+					topology.faceCorners[_face] = corner;
+					if (_self(_self, _face + 1))
+					{
+						return true;
+					}
+					used[corner] = false;
+				}
+			}
+			return false;
+		} };
+		assign(assign, 0);
+		for (std::size_t mask{}; mask < 64; mask++)
+		{
+			std::size_t size{};
+			for (std::size_t f{}; f < 6; f++)
+			{
+				if (!(mask & (1u << f)))
+				{
+					const QuadVertData<unsigned char>& face{ topology.faces[f] };
+					const std::size_t last{ static_cast<std::size_t>(std::find(face.begin(), face.end(), topology.faceCorners[f]) - face.begin()) };
+					// same winding, rotated to end with the face corner
+					for (std::size_t i{ 1 }; i <= 4; i++)
+					{
+						topology.faceLists[mask][size++] = face[(last + i) % 4];
+					}
+				}
+			}
+			topology.faceListSizes[mask] = static_cast<unsigned char>(size);
+			size = 0;
+			for (std::size_t e{}; e < 12; e++)
+			{
+				const EdgeVertData<unsigned char>& faces{ topology.edgeFaces[e] };
+				if (!((mask & (1u << faces[0])) && (mask & (1u << faces[1]))))
+				{
+					topology.edgeLists[mask][size++] = topology.edges[e][0];
+					topology.edgeLists[mask][size++] = topology.edges[e][1];
+				}
+			}
+			topology.edgeListSizes[mask] = static_cast<unsigned char>(size);
+		}
+		return topology;
+	}() };
+
+	void HexDrawable::faceNormal(std::size_t _face, float* _normal) const
+	{
+		const QuadVertData<unsigned char>& face{ topology.faces[_face] };
+		const float* const v0{ m_verts.data() + face[0] * 3 }, * const v1{ m_verts.data() + face[1] * 3 };
+		const float* const v2{ m_verts.data() + face[2] * 3 }, * const v3{ m_verts.data() + face[3] * 3 };
+		const float a[3]{ v2[0] - v0[0], v2[1] - v0[1], v2[2] - v0[2] };
+		const float b[3]{ v3[0] - v1[0], v3[1] - v1[1], v3[2] - v1[2] };
+		_normal[0] = a[1] * b[2] - a[2] * b[1];
+		_normal[1] = a[2] * b[0] - a[0] * b[2];
+		_normal[2] = a[0] * b[1] - a[1] * b[0];
+		const float length{ std::sqrt(_normal[0] * _normal[0] + _normal[1] * _normal[1] + _normal[2] * _normal[2]) };
+		const float scale{ length > 0.0f ? (m_inverted ? -1.0f : 1.0f) / length : 0.0f };
+		_normal[0] *= scale;
+		_normal[1] *= scale;
+		_normal[2] *= scale;
+	}
+
+	void HexDrawable::setVerts(const HexVerts& _verts)
+	{
+		for (std::size_t i{}; i < 8; i++)
+		{
+			for (std::size_t d{}; d < 3; d++)
+			{
+				m_verts[i * 3 + d] = static_cast<float>(_verts[i][d]);
+			}
+		}
+		// the x- face normal points away from the x+ face unless the hexahedron is mirrored
+		const QuadVertData<std::size_t>& inner{ hexUtils::hexFaceInds[0] }, & outer{ hexUtils::hexFaceInds[1] };
+		const RVec3 normal{ (_verts[inner[2]] - _verts[inner[0]]).cross(_verts[inner[3]] - _verts[inner[1]]) };
+		const RVec3 away{ _verts[inner[0]] + _verts[inner[1]] + _verts[inner[2]] + _verts[inner[3]] - _verts[outer[0]] - _verts[outer[1]] - _verts[outer[2]] - _verts[outer[3]] };
+		m_inverted = normal.dot(away) < 0;
+	}
+
+	void HexDrawable::setColor(const cinolib::Color& _color)
+	{
+		m_color = _color;
+	}
+
+	void HexDrawable::setCulledFaces(std::uint8_t _faces)
+	{
+		m_culledFaces = _faces & c_allFaces;
+	}
+
+	std::uint8_t HexDrawable::culledFaces() const
+	{
+		return m_culledFaces;
+	}
+
+	cinolib::ObjectType HexDrawable::object_type() const
+	{
+		return cinolib::DRAWABLE_HEXMESH;
+	}
+
+	void HexDrawable::beginFaces()
+	{
+		glPushAttrib(GL_ENABLE_BIT | GL_LINE_BIT | GL_CURRENT_BIT | GL_LIGHTING_BIT | GL_POLYGON_BIT | GL_COLOR_BUFFER_BIT);
+		glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+		glEnable(GL_LIGHTING);
+		glEnable(GL_COLOR_MATERIAL);
+		glColorMaterial(GL_FRONT_AND_BACK, GL_AMBIENT_AND_DIFFUSE);
+		glShadeModel(GL_FLAT);
+		glEnable(GL_CULL_FACE);
+		glCullFace(GL_BACK);
+		glFrontFace(GL_CCW);
+		glEnable(GL_POLYGON_OFFSET_FILL);
+		glPolygonOffset(1.0f, 1.0f);
+		// opaque colors blend to themselves
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		glEnableClientState(GL_VERTEX_ARRAY);
+		glEnableClientState(GL_NORMAL_ARRAY);
+	}
+
+	void HexDrawable::beginEdges()
+	{
+		glPushAttrib(GL_ENABLE_BIT | GL_LINE_BIT | GL_CURRENT_BIT | GL_LIGHTING_BIT | GL_POLYGON_BIT | GL_COLOR_BUFFER_BIT);
+		glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+		glDisable(GL_LIGHTING);
+		glDisable(GL_BLEND);
+		glLineWidth(2.0f);
+		glColor4f(0.0f, 0.0f, 0.0f, 1.0f);
+		glEnableClientState(GL_VERTEX_ARRAY);
+	}
+
+	void HexDrawable::end()
+	{
+		glPopClientAttrib();
+		glPopAttrib();
+	}
+
+	void HexDrawable::drawFaces() const
+	{
+		// only the face corners are read
+		float normals[8 * 3]{};
+		for (std::size_t f{}; f < 6; f++)
+		{
+			if (!(m_culledFaces & (1u << f)))
+			{
+				faceNormal(f, normals + topology.faceCorners[f] * 3);
+			}
+		}
+		glColor4f(m_color.r(), m_color.g(), m_color.b(), m_color.a());
+		glVertexPointer(3, GL_FLOAT, 0, m_verts.data());
+		glNormalPointer(GL_FLOAT, 0, normals);
+		glDrawElements(GL_QUADS, topology.faceListSizes[m_culledFaces], GL_UNSIGNED_BYTE, topology.faceLists[m_culledFaces].data());
+	}
+
+	void HexDrawable::drawEdges() const
+	{
+		glVertexPointer(3, GL_FLOAT, 0, m_verts.data());
+		glDrawElements(GL_LINES, topology.edgeListSizes[m_culledFaces], GL_UNSIGNED_BYTE, topology.edgeLists[m_culledFaces].data());
+	}
+
+	void HexDrawable::draw(const float _sceneSize) const
+	{
+		if (!visible || m_culledFaces == c_allFaces)
+		{
+			return;
+		}
+		beginFaces();
+		glFrontFace(m_inverted ? GL_CW : GL_CCW);
+		drawFaces();
+		end();
+		if (wireframe)
+		{
+			beginEdges();
+			drawEdges();
+			end();
+		}
+	}
+
+	cinolib::vec3d HexDrawable::scene_center() const
+	{
+		cinolib::vec3d center{};
+		for (std::size_t i{}; i < 8; i++)
+		{
+			center += cinolib::vec3d{ m_verts[i * 3], m_verts[i * 3 + 1], m_verts[i * 3 + 2] };
+		}
+		return center / 8;
+	}
+
+	float HexDrawable::scene_radius() const
+	{
+		const cinolib::vec3d center{ scene_center() };
+		double radius{};
+		for (std::size_t i{}; i < 8; i++)
+		{
+			radius = std::max(radius, center.dist(cinolib::vec3d{ m_verts[i * 3], m_verts[i * 3 + 1], m_verts[i * 3 + 2] }));
+		}
+		return static_cast<float>(radius);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include <RSE/HexDrawableBatch.hpp>
+
+#include <cinolib/gl/gl_glfw.h>
+#include <algorithm>
+
+namespace RSE
+{
+
+	HexDrawableBatch::HexDrawableBatch(const std::vector<HexDrawable*>& _hexes) : m_hexes{ _hexes }
+	{}
+
+	cinolib::ObjectType HexDrawableBatch::object_type() const
+	{
+		return cinolib::DRAWABLE_HEXMESH;
+	}
+
+	void HexDrawableBatch::draw(const float _sceneSize) const
+	{
+		if (m_hexes.empty())
+		{
+			return;
+		}
+		// faces, with the winding switched once for the mirrored hexahedra
+		HexDrawable::beginFaces();
+		for (const bool inverted : { false, true })
+		{
+			glFrontFace(inverted ? GL_CW : GL_CCW);
+			for (const HexDrawable* hex : m_hexes)
+			{
+				if (hex->visible && hex->m_inverted == inverted && hex->m_culledFaces != HexDrawable::c_allFaces)
+				{
+					hex->drawFaces();
+				}
+			}
+		}
+		HexDrawable::end();
+		// edges
+		HexDrawable::beginEdges();
+		for (const HexDrawable* hex : m_hexes)
+		{
+			if (hex->visible && hex->wireframe && hex->m_culledFaces != HexDrawable::c_allFaces)
+			{
+				hex->drawEdges();
+			}
+		}
+		HexDrawable::end();
+	}
+
+	cinolib::vec3d HexDrawableBatch::scene_center() const
+	{
+		cinolib::vec3d center{};
+		std::size_t count{};
+		for (const HexDrawable* hex : m_hexes)
+		{
+			if (hex->visible)
+			{
+				center += hex->scene_center();
+				count++;
+			}
+		}
+		return count ? center / static_cast<double>(count) : center;
+	}
+
+	float HexDrawableBatch::scene_radius() const
+	{
+		const cinolib::vec3d center{ scene_center() };
+		double radius{};
+		for (const HexDrawable* hex : m_hexes)
+		{
+			if (hex->visible)
+			{
+				radius = std::max(radius, center.dist(hex->scene_center()) + hex->scene_radius());
+			}
+		}
+		return static_cast<float>(radius);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,159 @@
+#include <RSE/InputLog.hpp>
+
+#include <RSE/schemeIO.hpp>
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+namespace RSE
+{
+
+	namespace
+	{
+
+		constexpr const char* c_header{ "rse-input 1" };
+
+	}
+
+	void InputLog::write(std::ostream& _stream) const
+	{
+		_stream << c_header << '\n';
+		if (file)
+		{
+			_stream << "f " << *file << '\n';
+		}
+		for (const Event& event : events)
+		{
+			switch (event.type)
+			{
+				case EType::Key:
+					_stream << "k " << event.microseconds << ' ' << event.key << ' ' << event.modifiers;
+					break;
+				case EType::MouseRay:
+					_stream << "m " << event.microseconds;
+					for (unsigned int d{}; d < 3; d++)
+					{
+						_stream << ' ' << event.origin[d];
+					}
+					for (unsigned int d{}; d < 3; d++)
+					{
+						_stream << ' ' << event.dir[d];
+					}
+					break;
+				case EType::Click:
+					_stream << "c " << event.microseconds << ' ' << event.modifiers;
+					break;
+				case EType::Model:
+					_stream << "e " << event.microseconds << ' ' << event.key;
+					break;
+				case EType::Command:
+					_stream << "x " << event.microseconds << ' ' << event.text;
+					break;
+				case EType::Script:
+					_stream << "s " << event.microseconds << ' ' << event.text;
+					break;
+			}
+			_stream << '\n';
+		}
+	}
+
+	InputLog InputLog::read(std::istream& _stream)
+	{
+		InputLog log{};
+		std::string line{};
+		if (!std::getline(_stream, line) || line != c_header)
+		{
+			throw std::runtime_error{ "not an input log" };
+		}
+		char type{};
+		while (_stream >> type)
+		{
+			if (type == 'f')
+			{
+				_stream.get();
+				std::string file{};
+				std::getline(_stream, file);
+				log.file = file;
+				continue;
+			}
+			Event event{};
+			_stream >> event.microseconds;
+			switch (type)
+			{
+				case 'k':
+					event.type = EType::Key;
+					_stream >> event.key >> event.modifiers;
+					break;
+				case 'm':
+					event.type = EType::MouseRay;
+					_stream >> event.origin.x() >> event.origin.y() >> event.origin.z() >> event.dir.x() >> event.dir.y() >> event.dir.z();
+					break;
+				case 'c':
+					event.type = EType::Click;
+					_stream >> event.modifiers;
+					break;
+				case 'e':
+					event.type = EType::Model;
+					_stream >> event.key;
+					break;
+				case 'x':
+				case 's':
+					event.type = type == 'x' ? EType::Command : EType::Script;
+					_stream.get();
+					std::getline(_stream, event.text);
+					break;
+				default:
+					throw std::runtime_error{ "unknown event type" };
+			}
+			if (!_stream)
+			{
+				throw std::runtime_error{ "malformed input log" };
+			}
+			log.events.push_back(event);
+		}
+		return log;
+	}
+
+	void InputLog::save(const std::string& _filename) const
+	{
+		schemeIO::writeAtomic(_filename, [this](std::ostream& _stream) { write(_stream); });
+	}
+
+	InputLog InputLog::load(const std::string& _filename)
+	{
+		std::ifstream file{};
+		file.open(_filename);
+		if (!file)
+		{
+			throw std::runtime_error{ "cannot open '" + _filename + "'" };
+		}
+		InputLog log{ read(file) };
+		file.close();
+		return log;
+	}
+
+	void LatencyReport::add(const std::string& _handler, Real _seconds)
+	{
+		seconds[_handler].push_back(_seconds);
+	}
+
+	std::ostream& operator<<(std::ostream& _stream, const LatencyReport& _report)
+	{
+		_stream << "model events: " << _report.replayedModelEvents << " replayed, " << _report.recordedModelEvents << " recorded";
+		for (const auto& [handler, samples] : _report.seconds)
+		{
+			std::vector<Real> sorted{ samples };
+			std::sort(sorted.begin(), sorted.end());
+			const auto percentile{ [&sorted](std::size_t _percent) {
+				return sorted[std::min(sorted.size() - 1, sorted.size() * _percent / 100)] * 1e6;
+			} };
+			_stream << '\n' << handler << ": " << sorted.size() << " calls"
+				<< ", p50: " << percentile(50) << "us"
+				<< ", p90: " << percentile(90) << "us"
+				<< ", p99: " << percentile(99) << "us"
+				<< ", max: " << sorted.back() * 1e6 << "us";
+		}
+		return _stream;
+	}
+
+}
\ No newline at end of file
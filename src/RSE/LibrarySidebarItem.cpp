@@ -0,0 +1,111 @@
+#include <RSE/LibrarySidebarItem.hpp>
+
+#include <cinolib/gl/file_dialog_open.h>
+#include <cinolib/gl/gl_glfw.h>
+#include <imgui.h>
+#include <filesystem>
+#include <cstdint>
+
+namespace RSE
+{
+
+	LibrarySidebarItem::LibrarySidebarItem(AppSidebarItem& _app) : cinolib::SideBarItem{ "Library" }, m_app{ _app }, m_library{}, m_textures{}
+	{}
+
+	LibrarySidebarItem::~LibrarySidebarItem()
+	{
+		clearTextures();
+	}
+
+	void LibrarySidebarItem::clearTextures()
+	{
+		for (const auto& [filename, texture] : m_textures)
+		{
+			glDeleteTextures(1, &texture);
+		}
+		m_textures.clear();
+	}
+
+	void LibrarySidebarItem::open(const std::string& _directory)
+	{
+		clearTextures();
+		m_library.open(_directory);
+	}
+
+	void LibrarySidebarItem::open()
+	{
+		const std::string filename{ cinolib::file_dialog_open() };
+		if (!filename.empty())
+		{
+			open(std::filesystem::path{ filename }.parent_path().string());
+		}
+	}
+
+	void LibrarySidebarItem::draw()
+	{
+		for (const SchemeLibrary::Thumbnail& thumbnail : m_library.poll())
+		{
+			unsigned int& texture{ m_textures[thumbnail.filename] };
+			if (!texture)
+			{
+				glGenTextures(1, &texture);
+			}
+			glBindTexture(GL_TEXTURE_2D, texture);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, SchemeLibrary::c_thumbnailSize, SchemeLibrary::c_thumbnailSize, 0, GL_RGBA, GL_UNSIGNED_BYTE, thumbnail.pixels.data());
+			glBindTexture(GL_TEXTURE_2D, 0);
+		}
+		if (ImGui::Button("Open directory"))
+		{
+			open();
+		}
+		if (m_library.directory().empty())
+		{
+			return;
+		}
+		ImGui::SameLine();
+		if (ImGui::Button("Refresh"))
+		{
+			open(m_library.directory());
+		}
+		ImGui::TextDisabled("%s", m_library.directory().c_str());
+		if (m_library.busy())
+		{
+			ImGui::TextDisabled("Indexing...");
+		}
+		ImGui::Spacing();
+		const float size{ static_cast<float>(SchemeLibrary::c_thumbnailSize) };
+		for (const SchemeLibrary::Entry& entry : m_library.entries())
+		{
+			ImGui::PushID(entry.filename.c_str());
+			const auto texture{ m_textures.find(entry.filename) };
+			if (texture != m_textures.end())
+			{
+				ImGui::Image(reinterpret_cast<ImTextureID>(static_cast<std::intptr_t>(texture->second)), ImVec2{ size, size });
+			}
+			else
+			{
+				ImGui::Dummy(ImVec2{ size, size });
+			}
+			ImGui::SameLine();
+			ImGui::BeginGroup();
+			ImGui::Text("%s", entry.filename.c_str());
+			if (entry.valid)
+			{
+				ImGui::TextDisabled("size %d, %d children", static_cast<int>(entry.size), static_cast<int>(entry.childCount));
+				if (!m_app.loading() && ImGui::SmallButton("Open"))
+				{
+					m_app.load(m_library.path(entry));
+				}
+			}
+			else
+			{
+				ImGui::TextDisabled("...");
+			}
+			ImGui::EndGroup();
+			ImGui::PopID();
+		}
+	}
+
+}
\ No newline at end of file
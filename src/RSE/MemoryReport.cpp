@@ -0,0 +1,37 @@
+#include <RSE/MemoryReport.hpp>
+
+namespace RSE
+{
+
+	void MemoryReport::add(const std::string& _subsystem, std::size_t _count, std::size_t _bytes)
+	{
+		Entry& entry{ subsystems[_subsystem] };
+		entry.count += _count;
+		entry.bytes += _bytes;
+	}
+
+	std::size_t MemoryReport::bytes() const
+	{
+		std::size_t bytes{};
+		for (const auto& [subsystem, entry] : subsystems)
+		{
+			bytes += entry.bytes;
+		}
+		return bytes;
+	}
+
+	std::ostream& operator<<(std::ostream& _stream, const MemoryReport& _report)
+	{
+		_stream << "total: " << _report.bytes() / 1024 << "KiB";
+		for (const auto& [subsystem, entry] : _report.subsystems)
+		{
+			_stream << '\n' << subsystem << ": " << entry.bytes / 1024 << "KiB, " << entry.count << " items";
+			if (entry.count)
+			{
+				_stream << ", " << entry.bytes / entry.count << "B per item";
+			}
+		}
+		return _stream;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#include <RSE/MemorySidebarItem.hpp>
+
+#include <imgui.h>
+
+namespace RSE
+{
+
+	MemorySidebarItem::MemorySidebarItem() : cinolib::SideBarItem{ "Memory" }, onReport{}
+	{}
+
+	const MemoryReport& MemorySidebarItem::refresh()
+	{
+		m_report = MemoryReport{};
+		onReport(*m_report);
+		return *m_report;
+	}
+
+	void MemorySidebarItem::draw()
+	{
+		// measuring walks every child, so it only happens on request
+		if (!m_report)
+		{
+			refresh();
+		}
+		if (ImGui::Button("Refresh"))
+		{
+			refresh();
+		}
+		ImGui::SameLine();
+		ImGui::Text("Total: %.1f MiB", static_cast<double>(m_report->bytes()) / (1024.0 * 1024.0));
+		ImGui::Spacing();
+		for (const auto& [subsystem, entry] : m_report->subsystems)
+		{
+			ImGui::Text("%s", subsystem.c_str());
+			ImGui::TextDisabled("  %.1f KiB, %d items", static_cast<double>(entry.bytes) / 1024.0, static_cast<int>(entry.count));
+			if (entry.count)
+			{
+				ImGui::SameLine();
+				ImGui::TextDisabled("(%d B each)", static_cast<int>(entry.bytes / entry.count));
+			}
+		}
+	}
+
+}
\ No newline at end of file
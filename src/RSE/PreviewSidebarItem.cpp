@@ -0,0 +1,120 @@
+#include <RSE/PreviewSidebarItem.hpp>
+
+#include <cinolib/gl/file_dialog_open.h>
+#include <RSE/meshIO.hpp>
+#include <imgui.h>
+#include <chrono>
+#include <iostream>
+#include <exception>
+
+namespace RSE
+{
+
+	PreviewSidebarItem::PreviewSidebarItem(const AppSidebarItem& _app) : cinolib::SideBarItem{ "Preview" }, m_app{ _app }, onMeshUpdate{}
+	{}
+
+	const std::optional<std::string>& PreviewSidebarItem::file() const
+	{
+		return m_file;
+	}
+
+	const Refiner::Mesh& PreviewSidebarItem::source() const
+	{
+		return m_source;
+	}
+
+	const std::optional<Refiner::Mesh>& PreviewSidebarItem::mesh() const
+	{
+		return m_mesh;
+	}
+
+	Real PreviewSidebarItem::hexesPerSecond() const
+	{
+		return m_hexesPerSecond;
+	}
+
+	void PreviewSidebarItem::load(const std::string& _filename)
+	{
+		try
+		{
+			m_source = meshIO::load(_filename);
+		}
+		catch (const std::exception& _exception)
+		{
+			std::cerr << "failed to load hexmesh '" << _filename << "': " << _exception.what() << std::endl;
+			return;
+		}
+		m_file = _filename;
+		refine();
+	}
+
+	void PreviewSidebarItem::load()
+	{
+		const std::string filename{ cinolib::file_dialog_open() };
+		if (!filename.empty())
+		{
+			load(filename);
+		}
+	}
+
+	void PreviewSidebarItem::refine()
+	{
+		if (!m_file)
+		{
+			return;
+		}
+		const auto start{ std::chrono::steady_clock::now() };
+		m_mesh = Refiner{}(m_app.source().size(), *m_app.snapshot(), m_source).mesh();
+		const std::chrono::duration<Real> elapsed{ std::chrono::steady_clock::now() - start };
+		m_hexesPerSecond = elapsed.count() > 0 ? static_cast<Real>(m_source.hexes.size()) / elapsed.count() : 0;
+		onMeshUpdate();
+	}
+
+	void PreviewSidebarItem::clear()
+	{
+		m_file = std::nullopt;
+		m_source = {};
+		m_mesh = std::nullopt;
+		m_hexesPerSecond = 0;
+		onMeshUpdate();
+	}
+
+	void PreviewSidebarItem::draw()
+	{
+		if (m_app.loading())
+		{
+			ImGui::TextDisabled("Waiting for the scheme...");
+			return;
+		}
+		if (m_file)
+		{
+			ImGui::TextDisabled("%s", m_file->c_str());
+			ImGui::Spacing();
+		}
+		if (m_mesh)
+		{
+			ImGui::TextDisabled("%d hexes -> %d hexes", static_cast<int>(m_source.hexes.size()), static_cast<int>(m_mesh->hexes.size()));
+			ImGui::TextDisabled("%d verts -> %d verts", static_cast<int>(m_source.verts.size()), static_cast<int>(m_mesh->verts.size()));
+			ImGui::TextDisabled("%.0f hexes/s", m_hexesPerSecond);
+			ImGui::Spacing();
+		}
+		if (ImGui::Button("Load mesh"))
+		{
+			load();
+		}
+		if (m_file)
+		{
+			ImGui::SameLine();
+			if (ImGui::Button("Apply"))
+			{
+				refine();
+			}
+			ImGui::SameLine();
+			if (ImGui::Button("Clear"))
+			{
+				clear();
+			}
+		}
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,322 @@
+#include <RSE/Refiner.hpp>
+
+#include <RSE/parallel.hpp>
+#include <RSE/hexUtils.hpp>
+#include <RSE/WeightTable.hpp>
+#include <RSE/schemeIO.hpp>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace RSE
+{
+
+	namespace
+	{
+
+		constexpr std::size_t c_unused{ std::numeric_limits<std::size_t>::max() };
+
+		// rotates the quad so that it starts from its smallest vertex and continues toward its smallest neighbor
+		QuadVertData<std::size_t> canonicalFace(const QuadVertData<std::size_t>& _verts)
+		{
+			const std::size_t first{ static_cast<std::size_t>(std::min_element(_verts.begin(), _verts.end()) - _verts.begin()) };
+			const bool forward{ _verts[(first + 1) % 4] < _verts[(first + 3) % 4] };
+			QuadVertData<std::size_t> face;
+			for (std::size_t i{}; i < 4; i++)
+			{
+				face[i] = _verts[(first + (forward ? i : 4 - i)) % 4];
+			}
+			return face;
+		}
+
+		template<typename TKey, std::size_t TCount, typename TMakeKey>
+		std::vector<TKey> numberEntities(const Refiner::Mesh& _source, std::vector<std::array<std::size_t, TCount>>& _hexEntities, const TMakeKey& _makeKey)
+		{
+			std::vector<std::pair<TKey, std::size_t>> refs(_source.hexes.size() * TCount);
+			parallel::forEach(_source.hexes.size(), [&](std::size_t _hex) {
+				for (std::size_t e{}; e < TCount; e++)
+				{
+					refs[_hex * TCount + e] = { _makeKey(_source.hexes[_hex], e), _hex * TCount + e };
+				}
+			});
+			std::sort(refs.begin(), refs.end());
+			std::vector<TKey> entities{};
+			_hexEntities.resize(_source.hexes.size());
+			for (std::size_t r{}; r < refs.size(); r++)
+			{
+				if (!r || refs[r].first != refs[r - 1].first)
+				{
+					entities.push_back(refs[r].first);
+				}
+				_hexEntities[refs[r].second / TCount][refs[r].second % TCount] = entities.size() - 1;
+			}
+			return entities;
+		}
+
+	}
+
+	std::size_t Refiner::Refinement::slot(std::size_t _hex, const Point& _point) const
+	{
+		const HexVertData<std::size_t>& hex{ m_source->hexes[_hex] };
+		const std::size_t inner{ static_cast<std::size_t>(m_size - 1) };
+		switch (_point.type)
+		{
+			case EPointType::Corner:
+				return hex[_point.entity];
+			case EPointType::Edge:
+			{
+				const EdgeVertData<std::size_t>& corners{ hexUtils::hexEdgeInds[_point.entity] };
+				const unsigned int dim{ static_cast<unsigned int>(_point.entity / 4) };
+				const Int t{ hex[corners[0]] < hex[corners[1]] ? _point.coord[dim] : m_size - _point.coord[dim] };
+				return m_source->verts.size() + m_hexEdges[_hex][_point.entity] * inner + static_cast<std::size_t>(t - 1);
+			}
+			case EPointType::Face:
+			{
+				QuadVertData<std::size_t> corners{ hexUtils::hexFaceInds[_point.entity] };
+				QuadVertData<std::size_t> verts;
+				for (std::size_t i{}; i < 4; i++)
+				{
+					verts[i] = hex[corners[i]];
+				}
+				const std::size_t first{ static_cast<std::size_t>(std::min_element(verts.begin(), verts.end()) - verts.begin()) };
+				const std::size_t origin{ corners[first] };
+				const std::size_t next{ corners[(first + 1) % 4] }, prev{ corners[(first + 3) % 4] };
+				const bool forward{ verts[(first + 1) % 4] < verts[(first + 3) % 4] };
+				Int uv[2];
+				for (std::size_t a{}; a < 2; a++)
+				{
+					const std::size_t along{ (a == 0) == forward ? next : prev };
+					const unsigned int dim{ static_cast<unsigned int>(std::countr_zero(origin ^ along)) };
+					uv[a] = (origin >> dim) & 1 ? m_size - _point.coord[dim] : _point.coord[dim];
+				}
+				return m_source->verts.size() + m_edges.size() * inner
+					+ m_hexFaces[_hex][_point.entity] * inner * inner + static_cast<std::size_t>(uv[0] - 1) * inner + static_cast<std::size_t>(uv[1] - 1);
+			}
+			default:
+				return m_boundaryVertCount + _hex * m_interiorCount + _point.entity;
+		}
+	}
+
+	const std::vector<RVec3>& Refiner::Refinement::verts() const
+	{
+		return m_verts;
+	}
+
+	std::size_t Refiner::Refinement::sourceHexCount() const
+	{
+		return m_source->hexes.size();
+	}
+
+	std::size_t Refiner::Refinement::hexCount() const
+	{
+		return m_source->hexes.size() * m_children.size();
+	}
+
+	const std::vector<HexVertData<std::size_t>>& Refiner::Refinement::children() const
+	{
+		return m_children;
+	}
+
+	std::size_t Refiner::Refinement::pointCount() const
+	{
+		return m_points.size();
+	}
+
+	void Refiner::Refinement::pointVerts(std::size_t _sourceHex, std::size_t* _out) const
+	{
+		for (std::size_t p{}; p < m_points.size(); p++)
+		{
+			const std::size_t index{ slot(_sourceHex, m_points[p]) };
+			_out[p] = m_points[p].type == EPointType::Interior ? index : m_slots[index];
+		}
+	}
+
+	Refiner::Mesh Refiner::Refinement::mesh() const
+	{
+		Mesh mesh{};
+		mesh.verts = m_verts;
+		mesh.hexes.resize(hexCount());
+		parallel::forEachChunk(m_source->hexes.size(), 256, [&](std::size_t _begin, std::size_t _end) {
+			std::vector<std::size_t> verts(m_points.size());
+			for (std::size_t h{ _begin }; h < _end; h++)
+			{
+				pointVerts(h, verts.data());
+				for (std::size_t c{}; c < m_children.size(); c++)
+				{
+					for (std::size_t i{}; i < 8; i++)
+					{
+						mesh.hexes[h * m_children.size() + c][i] = verts[m_children[c][i]];
+					}
+				}
+			}
+		});
+		return mesh;
+	}
+
+	Refiner::Refinement Refiner::operator()(Int _size, const std::vector<HexVertsU>& _children, const Mesh& _source) const
+	{
+		// the point lattice is indexed by the child coordinates
+		schemeIO::validate(_size, _children);
+		Refinement refinement{};
+		refinement.m_source = &_source;
+		refinement.m_size = _size;
+		const std::size_t inner{ static_cast<std::size_t>(_size - 1) };
+		// scheme points
+		{
+			const Int layers{ _size + 1 };
+			std::vector<std::size_t> pointMap(static_cast<std::size_t>(layers * layers * layers), c_unused);
+			refinement.m_children.reserve(_children.size());
+			for (const HexVertsU& child : _children)
+			{
+				HexVertData<std::size_t> inds;
+				for (std::size_t i{}; i < 8; i++)
+				{
+					const IVec3& coord{ child[i] };
+					std::size_t& index{ pointMap[static_cast<std::size_t>((coord.z() * layers + coord.y()) * layers + coord.x())] };
+					if (index == c_unused)
+					{
+						index = refinement.m_points.size();
+						Refinement::Point point{ .coord{ coord } };
+						std::size_t bits{}, boundary{}, free{}, fixed{};
+						for (unsigned int d{}; d < 3; d++)
+						{
+							if (coord[d] == 0 || coord[d] == _size)
+							{
+								bits |= static_cast<std::size_t>(coord[d] == _size) << d;
+								boundary++;
+								fixed = d;
+							}
+							else
+							{
+								free = d;
+							}
+						}
+						switch (boundary)
+						{
+							case 3:
+								point.type = Refinement::EPointType::Corner;
+								point.entity = bits;
+								break;
+							case 2:
+								point.type = Refinement::EPointType::Edge;
+								point.entity = static_cast<std::size_t>(std::find(hexUtils::hexEdgeInds.begin(), hexUtils::hexEdgeInds.end(), EdgeVertData<std::size_t>{ bits, bits | (std::size_t{ 1 } << free) }) - hexUtils::hexEdgeInds.begin());
+								break;
+							case 1:
+								point.type = Refinement::EPointType::Face;
+								point.entity = fixed * 2 + ((bits >> fixed) & 1);
+								break;
+							default:
+								point.type = Refinement::EPointType::Interior;
+								point.entity = refinement.m_interiorCount++;
+								break;
+						}
+						refinement.m_points.push_back(point);
+					}
+					inds[i] = index;
+				}
+				refinement.m_children.push_back(inds);
+			}
+		}
+		// source edges and faces
+		refinement.m_edges = numberEntities<EdgeVertData<std::size_t>>(_source, refinement.m_hexEdges, [](const HexVertData<std::size_t>& _hex, std::size_t _edge) {
+			const EdgeVertData<std::size_t>& corners{ hexUtils::hexEdgeInds[_edge] };
+			return EdgeVertData<std::size_t>{ std::min(_hex[corners[0]], _hex[corners[1]]), std::max(_hex[corners[0]], _hex[corners[1]]) };
+		});
+		refinement.m_faces = numberEntities<QuadVertData<std::size_t>>(_source, refinement.m_hexFaces, [](const HexVertData<std::size_t>& _hex, std::size_t _face) {
+			QuadVertData<std::size_t> verts;
+			for (std::size_t i{}; i < 4; i++)
+			{
+				verts[i] = _hex[hexUtils::hexFaceInds[_face][i]];
+			}
+			return canonicalFace(verts);
+		});
+		// used boundary slots
+		const std::size_t edgeBase{ _source.verts.size() };
+		const std::size_t faceBase{ edgeBase + refinement.m_edges.size() * inner };
+		const std::size_t boundarySlots{ faceBase + refinement.m_faces.size() * inner * inner };
+		{
+			std::vector<std::atomic<bool>> used(boundarySlots);
+			parallel::forEach(_source.hexes.size(), [&](std::size_t _hex) {
+				for (const Refinement::Point& point : refinement.m_points)
+				{
+					if (point.type != Refinement::EPointType::Interior)
+					{
+						used[refinement.slot(_hex, point)].store(true, std::memory_order_relaxed);
+					}
+				}
+			});
+			refinement.m_slots.resize(boundarySlots);
+			for (std::size_t s{}; s < boundarySlots; s++)
+			{
+				refinement.m_slots[s] = used[s].load(std::memory_order_relaxed) ? refinement.m_boundaryVertCount++ : c_unused;
+			}
+		}
+		// boundary verts
+		refinement.m_verts.resize(refinement.m_boundaryVertCount + _source.hexes.size() * refinement.m_interiorCount);
+		const Real step{ Real{ 1 } / static_cast<Real>(_size) };
+		parallel::forEach(boundarySlots, [&](std::size_t _slot) {
+			const std::size_t vert{ refinement.m_slots[_slot] };
+			if (vert == c_unused)
+			{
+				return;
+			}
+			if (_slot < edgeBase)
+			{
+				refinement.m_verts[vert] = _source.verts[_slot];
+			}
+			else if (_slot < faceBase)
+			{
+				const EdgeVertData<std::size_t>& edge{ refinement.m_edges[(_slot - edgeBase) / inner] };
+				const Real t{ static_cast<Real>((_slot - edgeBase) % inner + 1) * step };
+				refinement.m_verts[vert] = _source.verts[edge[0]] * (1 - t) + _source.verts[edge[1]] * t;
+			}
+			else
+			{
+				const QuadVertData<std::size_t>& face{ refinement.m_faces[(_slot - faceBase) / (inner * inner)] };
+				const std::size_t local{ (_slot - faceBase) % (inner * inner) };
+				const Real u{ static_cast<Real>(local / inner + 1) * step }, v{ static_cast<Real>(local % inner + 1) * step };
+				refinement.m_verts[vert] =
+					_source.verts[face[0]] * ((1 - u) * (1 - v))
+					+ _source.verts[face[1]] * (u * (1 - v))
+					+ _source.verts[face[2]] * (u * v)
+					+ _source.verts[face[3]] * ((1 - u) * v);
+			}
+		});
+		// interior verts
+		if (refinement.m_interiorCount)
+		{
+			std::vector<std::size_t> indices{};
+			const std::size_t layers{ static_cast<std::size_t>(_size + 1) };
+			for (const Refinement::Point& point : refinement.m_points)
+			{
+				if (point.type == Refinement::EPointType::Interior)
+				{
+					indices.push_back((static_cast<std::size_t>(point.coord.z()) * layers + static_cast<std::size_t>(point.coord.y())) * layers + static_cast<std::size_t>(point.coord.x()));
+				}
+			}
+			const WeightTable<Real> weights{ *WeightTable<Real>::lattice(_size), indices };
+			parallel::forEachChunk(_source.hexes.size(), 256, [&](std::size_t _begin, std::size_t _end) {
+				std::vector<Real> xs(refinement.m_interiorCount), ys(refinement.m_interiorCount), zs(refinement.m_interiorCount);
+				for (std::size_t h{ _begin }; h < _end; h++)
+				{
+					HexVerts hex;
+					for (std::size_t i{}; i < 8; i++)
+					{
+						hex[i] = _source.verts[_source.hexes[h][i]];
+					}
+					weights.apply(hex, xs.data(), ys.data(), zs.data());
+					RVec3* out{ refinement.m_verts.data() + refinement.m_boundaryVertCount + h * refinement.m_interiorCount };
+					for (std::size_t p{}; p < refinement.m_interiorCount; p++)
+					{
+						out[p] = RVec3{ xs[p], ys[p], zs[p] };
+					}
+				}
+			});
+		}
+		return refinement;
+	}
+
+}
\ No newline at end of file
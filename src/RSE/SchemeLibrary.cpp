@@ -0,0 +1,416 @@
+#include <RSE/SchemeLibrary.hpp>
+
+#include <RSE/schemeIO.hpp>
+#include <RSE/hexUtils.hpp>
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <utility>
+
+namespace RSE
+{
+
+	namespace
+	{
+
+		constexpr const char* c_indexHeader{ "rse-library 1" };
+		constexpr const char* c_thumbnailsHeader{ "rse-thumbnails 1" };
+		constexpr std::size_t c_thumbnailBytes{ static_cast<std::size_t>(SchemeLibrary::c_thumbnailSize * SchemeLibrary::c_thumbnailSize * 4) };
+
+		std::int64_t mtime(const std::filesystem::path& _path)
+		{
+			return static_cast<std::int64_t>(std::filesystem::last_write_time(_path).time_since_epoch().count());
+		}
+
+		std::array<unsigned char, 3> childColor(std::size_t _child)
+		{
+			// golden ratio hue steps
+			const float hue{ std::fmod(static_cast<float>(_child) * 0.618034f, 1.0f) * 6.0f };
+			const float x{ 1.0f - std::abs(std::fmod(hue, 2.0f) - 1.0f) };
+			float rgb[3]{};
+			switch (static_cast<int>(hue))
+			{
+				case 0: rgb[0] = 1; rgb[1] = x; break;
+				case 1: rgb[0] = x; rgb[1] = 1; break;
+				case 2: rgb[1] = 1; rgb[2] = x; break;
+				case 3: rgb[1] = x; rgb[2] = 1; break;
+				case 4: rgb[0] = x; rgb[2] = 1; break;
+				default: rgb[0] = 1; rgb[2] = x; break;
+			}
+			std::array<unsigned char, 3> color;
+			for (std::size_t c{}; c < 3; c++)
+			{
+				color[c] = static_cast<unsigned char>(80.0f + rgb[c] * 175.0f);
+			}
+			return color;
+		}
+
+		// runs of up to 255 equal RGBA pixels, as a count byte followed by the pixel
+		std::vector<unsigned char> encodeThumbnail(const std::vector<unsigned char>& _pixels)
+		{
+			std::vector<unsigned char> encoded{};
+			for (std::size_t i{}; i < _pixels.size();)
+			{
+				std::size_t run{ 1 };
+				while (run < 255 && i + run * 4 < _pixels.size() && std::equal(_pixels.begin() + static_cast<std::ptrdiff_t>(i), _pixels.begin() + static_cast<std::ptrdiff_t>(i + 4), _pixels.begin() + static_cast<std::ptrdiff_t>(i + run * 4)))
+				{
+					run++;
+				}
+				encoded.push_back(static_cast<unsigned char>(run));
+				encoded.insert(encoded.end(), _pixels.begin() + static_cast<std::ptrdiff_t>(i), _pixels.begin() + static_cast<std::ptrdiff_t>(i + 4));
+				i += run * 4;
+			}
+			return encoded;
+		}
+
+		// empty if _encoded is not a whole thumbnail
+		std::vector<unsigned char> decodeThumbnail(const std::vector<unsigned char>& _encoded)
+		{
+			std::vector<unsigned char> pixels{};
+			pixels.reserve(c_thumbnailBytes);
+			for (std::size_t i{}; i + 5 <= _encoded.size(); i += 5)
+			{
+				for (unsigned char r{}; r < _encoded[i] && pixels.size() < c_thumbnailBytes; r++)
+				{
+					pixels.insert(pixels.end(), _encoded.begin() + static_cast<std::ptrdiff_t>(i + 1), _encoded.begin() + static_cast<std::ptrdiff_t>(i + 5));
+				}
+			}
+			if (pixels.size() != c_thumbnailBytes || _encoded.size() % 5)
+			{
+				pixels.clear();
+			}
+			return pixels;
+		}
+
+	}
+
+	std::vector<unsigned char> SchemeLibrary::renderThumbnail(Int _size, const std::vector<HexVertsU>& _children)
+	{
+		constexpr int res{ c_thumbnailSize };
+		constexpr float margin{ 6.0f }, depthX{ 0.5f }, depthY{ 0.35f };
+		std::vector<unsigned char> pixels(static_cast<std::size_t>(res * res * 4));
+		for (std::size_t i{}; i < pixels.size(); i += 4)
+		{
+			pixels[i + 0] = pixels[i + 1] = pixels[i + 2] = 26;
+			pixels[i + 3] = 255;
+		}
+		if (_size < 1)
+		{
+			return pixels;
+		}
+		const float scale{ (static_cast<float>(res) - 2 * margin) / (1.0f + depthX) / static_cast<float>(_size) };
+		const auto project{ [&](const IVec3& _vert) {
+			const float x{ margin + (static_cast<float>(_vert.x()) + static_cast<float>(_vert.z()) * depthX) * scale };
+			const float y{ margin + (static_cast<float>(_vert.y()) + static_cast<float>(_vert.z()) * depthY) * scale };
+			return std::pair<float, float>{ x, static_cast<float>(res - 1) - y };
+		} };
+		for (std::size_t c{}; c < _children.size(); c++)
+		{
+			const std::array<unsigned char, 3> color{ childColor(c) };
+			for (const EdgeVertData<std::size_t>& edge : hexUtils::hexEdgeInds)
+			{
+				const auto [x0, y0] { project(_children[c][edge[0]]) };
+				const auto [x1, y1] { project(_children[c][edge[1]]) };
+				const int steps{ std::max(1, static_cast<int>(std::ceil(std::max(std::abs(x1 - x0), std::abs(y1 - y0))))) };
+				for (int s{}; s <= steps; s++)
+				{
+					const float t{ static_cast<float>(s) / static_cast<float>(steps) };
+					const int x{ static_cast<int>(std::lround(x0 + (x1 - x0) * t)) }, y{ static_cast<int>(std::lround(y0 + (y1 - y0) * t)) };
+					if (x >= 0 && y >= 0 && x < res && y < res)
+					{
+						unsigned char* pixel{ &pixels[static_cast<std::size_t>((y * res + x) * 4)] };
+						std::copy(color.begin(), color.end(), pixel);
+					}
+				}
+			}
+		}
+		return pixels;
+	}
+
+	SchemeLibrary::SchemeLibrary() : m_directory{}, m_entries{}, m_thumbnails{}, m_cachedThumbnails{}, m_pending{ 0 }, m_indexDirty{ false }, m_thumbnailsDirty{ false }, m_mutex{}, m_condition{}, m_jobs{}, m_results{}, m_generation{ 0 }, m_stop{ false }, m_thread{ [this]() { run(); } }
+	{}
+
+	SchemeLibrary::~SchemeLibrary()
+	{
+		{
+			const std::lock_guard lock{ m_mutex };
+			m_stop = true;
+		}
+		m_condition.notify_one();
+		m_thread.join();
+	}
+
+	void SchemeLibrary::run()
+	{
+		std::unique_lock lock{ m_mutex };
+		while (true)
+		{
+			m_condition.wait(lock, [this]() { return m_stop || !m_jobs.empty(); });
+			if (m_stop)
+			{
+				return;
+			}
+			const Job job{ std::move(m_jobs.front()) };
+			m_jobs.pop_front();
+			Result result{ m_generation, std::nullopt, Thumbnail{ job.filename, {} }, CachedThumbnail{ job.mtime, {} } };
+			const std::string path{ (std::filesystem::path{ m_directory } / job.filename).string() };
+			lock.unlock();
+			Entry entry{ job.filename, job.mtime, 0, 0, false };
+			try
+			{
+				const schemeIO::Scheme scheme{ schemeIO::load(path) };
+				entry.size = scheme.size;
+				entry.childCount = scheme.children.size();
+				entry.valid = true;
+				result.thumbnail.pixels = renderThumbnail(scheme.size, scheme.children);
+				result.cached.encoded = encodeThumbnail(result.thumbnail.pixels);
+			}
+			catch (const std::exception& _exception)
+			{
+				std::cerr << "Failed to read '" << path << "': " << _exception.what() << std::endl;
+			}
+			if (job.parse)
+			{
+				result.entry = entry;
+			}
+			lock.lock();
+			m_results.push_back(std::move(result));
+		}
+	}
+
+	void SchemeLibrary::readIndex()
+	{
+		m_entries.clear();
+		std::ifstream file{ std::filesystem::path{ m_directory } / c_indexFilename };
+		std::string line{};
+		if (!file || !std::getline(file, line) || line != c_indexHeader)
+		{
+			return;
+		}
+		while (std::getline(file, line))
+		{
+			std::istringstream stream{ line };
+			Entry entry{};
+			stream >> entry.mtime >> entry.size >> entry.childCount >> entry.valid;
+			stream.get();
+			std::getline(stream, entry.filename);
+			if (stream && !entry.filename.empty())
+			{
+				m_entries.push_back(std::move(entry));
+			}
+		}
+	}
+
+	void SchemeLibrary::writeIndex() const
+	{
+		schemeIO::writeAtomic((std::filesystem::path{ m_directory } / c_indexFilename).string(), [this](std::ostream& _stream) {
+			_stream << c_indexHeader << '\n';
+			for (const Entry& entry : m_entries)
+			{
+				_stream << entry.mtime << ' ' << entry.size << ' ' << entry.childCount << ' ' << entry.valid << ' ' << entry.filename << '\n';
+			}
+		});
+	}
+
+	void SchemeLibrary::readThumbnails()
+	{
+		m_thumbnails.clear();
+		std::ifstream file{ std::filesystem::path{ m_directory } / c_thumbnailsFilename, std::ios::binary };
+		std::string line{};
+		if (!file || !std::getline(file, line) || line != c_thumbnailsHeader)
+		{
+			return;
+		}
+		// filename, mtime and encoded size per record, all integers little-endian as written by writeThumbnails
+		const auto readInt{ [&file]<typename TInt>(TInt& _value) {
+			return static_cast<bool>(file.read(reinterpret_cast<char*>(&_value), sizeof(TInt)));
+		} };
+		std::uint32_t filenameSize{};
+		while (readInt(filenameSize))
+		{
+			std::string filename(filenameSize, '\0');
+			CachedThumbnail thumbnail{};
+			std::uint32_t encodedSize{};
+			if (!file.read(filename.data(), filenameSize) || !readInt(thumbnail.mtime) || !readInt(encodedSize) || encodedSize > c_thumbnailBytes / 4 * 5)
+			{
+				break;
+			}
+			thumbnail.encoded.resize(encodedSize);
+			if (!file.read(reinterpret_cast<char*>(thumbnail.encoded.data()), encodedSize))
+			{
+				break;
+			}
+			m_thumbnails[std::move(filename)] = std::move(thumbnail);
+		}
+	}
+
+	void SchemeLibrary::writeThumbnails() const
+	{
+		schemeIO::writeAtomic((std::filesystem::path{ m_directory } / c_thumbnailsFilename).string(), [this](std::ostream& _stream) {
+			const auto writeInt{ [&_stream]<typename TInt>(TInt _value) {
+				_stream.write(reinterpret_cast<const char*>(&_value), sizeof(TInt));
+			} };
+			_stream << c_thumbnailsHeader << '\n';
+			for (const auto& [filename, thumbnail] : m_thumbnails)
+			{
+				writeInt(static_cast<std::uint32_t>(filename.size()));
+				_stream.write(filename.data(), static_cast<std::streamsize>(filename.size()));
+				writeInt(thumbnail.mtime);
+				writeInt(static_cast<std::uint32_t>(thumbnail.encoded.size()));
+				_stream.write(reinterpret_cast<const char*>(thumbnail.encoded.data()), static_cast<std::streamsize>(thumbnail.encoded.size()));
+			}
+		}, true);
+	}
+
+	void SchemeLibrary::open(const std::string& _directory)
+	{
+		const std::lock_guard lock{ m_mutex };
+		m_generation++;
+		m_jobs.clear();
+		m_results.clear();
+		m_directory = _directory;
+		readIndex();
+		readThumbnails();
+		std::vector<Entry> entries{};
+		std::map<std::string, CachedThumbnail> thumbnails{};
+		std::size_t changed{};
+		m_cachedThumbnails.clear();
+		m_indexDirty = false;
+		try
+		{
+			for (const std::filesystem::directory_entry& file : std::filesystem::directory_iterator{ _directory })
+			{
+				if (!file.is_regular_file() || file.path().extension() != ".rse")
+				{
+					continue;
+				}
+				const std::string filename{ file.path().filename().string() };
+				const std::int64_t time{ mtime(file.path()) };
+				const auto cached{ std::find_if(m_entries.begin(), m_entries.end(), [&](const Entry& _entry) { return _entry.filename == filename; }) };
+				if (cached != m_entries.end() && cached->mtime == time)
+				{
+					entries.push_back(*cached);
+					// unchanged files are queued only if their thumbnail is not cached
+					const auto thumbnail{ m_thumbnails.find(filename) };
+					if (thumbnail != m_thumbnails.end() && thumbnail->second.mtime == time)
+					{
+						std::vector<unsigned char> pixels{ decodeThumbnail(thumbnail->second.encoded) };
+						if (!pixels.empty() || thumbnail->second.encoded.empty())
+						{
+							if (!pixels.empty())
+							{
+								m_cachedThumbnails.push_back(Thumbnail{ filename, std::move(pixels) });
+							}
+							thumbnails.insert(std::move(*thumbnail));
+							continue;
+						}
+					}
+					m_jobs.push_back(Job{ filename, time, false });
+				}
+				else
+				{
+					entries.push_back(Entry{ filename, time, 0, 0, false });
+					m_jobs.push_front(Job{ filename, time, true });
+					changed++;
+				}
+			}
+		}
+		catch (const std::exception& _exception)
+		{
+			std::cerr << "Failed to index '" << _directory << "': " << _exception.what() << std::endl;
+		}
+		m_indexDirty = changed || entries.size() != m_entries.size();
+		// thumbnails of removed or changed files are dropped
+		m_thumbnailsDirty = thumbnails.size() != m_thumbnails.size();
+		m_thumbnails = std::move(thumbnails);
+		std::sort(entries.begin(), entries.end(), [](const Entry& _a, const Entry& _b) { return _a.filename < _b.filename; });
+		m_entries = std::move(entries);
+		m_pending = m_jobs.size();
+		m_condition.notify_one();
+		std::cout << "Indexed " << m_entries.size() << " schemes (" << changed << " changed) in '" << _directory << "'" << std::endl;
+	}
+
+	const std::string& SchemeLibrary::directory() const
+	{
+		return m_directory;
+	}
+
+	const std::vector<SchemeLibrary::Entry>& SchemeLibrary::entries() const
+	{
+		return m_entries;
+	}
+
+	std::string SchemeLibrary::path(const Entry& _entry) const
+	{
+		return (std::filesystem::path{ m_directory } / _entry.filename).string();
+	}
+
+	bool SchemeLibrary::busy() const
+	{
+		return m_pending > 0;
+	}
+
+	std::vector<SchemeLibrary::Thumbnail> SchemeLibrary::poll()
+	{
+		std::vector<Result> results{};
+		{
+			const std::lock_guard lock{ m_mutex };
+			std::swap(results, m_results);
+		}
+		std::vector<Thumbnail> thumbnails{ std::move(m_cachedThumbnails) };
+		m_cachedThumbnails.clear();
+		for (Result& result : results)
+		{
+			if (result.generation != m_generation)
+			{
+				continue;
+			}
+			m_pending--;
+			if (result.entry)
+			{
+				const auto it{ std::find_if(m_entries.begin(), m_entries.end(), [&](const Entry& _entry) { return _entry.filename == result.entry->filename; }) };
+				if (it != m_entries.end())
+				{
+					*it = *result.entry;
+					m_indexDirty = true;
+				}
+			}
+			m_thumbnails[result.thumbnail.filename] = std::move(result.cached);
+			m_thumbnailsDirty = true;
+			if (!result.thumbnail.pixels.empty())
+			{
+				thumbnails.push_back(std::move(result.thumbnail));
+			}
+		}
+		if (!m_pending && m_indexDirty)
+		{
+			try
+			{
+				writeIndex();
+			}
+			catch (const std::exception& _exception)
+			{
+				std::cerr << "Failed to write the library index: " << _exception.what() << std::endl;
+			}
+			m_indexDirty = false;
+		}
+		if (!m_pending && m_thumbnailsDirty)
+		{
+			try
+			{
+				writeThumbnails();
+			}
+			catch (const std::exception& _exception)
+			{
+				std::cerr << "Failed to write the library thumbnails: " << _exception.what() << std::endl;
+			}
+			m_thumbnailsDirty = false;
+		}
+		return thumbnails;
+	}
+
+}
\ No newline at end of file
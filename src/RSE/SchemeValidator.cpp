@@ -0,0 +1,153 @@
+#include <RSE/SchemeValidator.hpp>
+
+#include <RSE/hexUtils.hpp>
+#include <RSE/parallel.hpp>
+#include <RSE/FaceIndex.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+namespace RSE
+{
+
+	bool SchemeValidator::Report::valid() const
+	{
+		return !gapCells && !overlapCells && !invalidChildren && !nonConformingFaces;
+	}
+
+	namespace
+	{
+
+		// inverts the trilinear map of _verts through Newton iterations
+		bool contains(const HexVerts& _verts, const RVec3& _point)
+		{
+			static constexpr Real c_eps{ 1e-9 };
+			RVec3 uvw{ 0.5, 0.5, 0.5 };
+			for (unsigned int iteration{}; iteration < 32; iteration++)
+			{
+				RVec3 value{ 0,0,0 }, du{ 0,0,0 }, dv{ 0,0,0 }, dw{ 0,0,0 };
+				for (std::size_t i{}; i < 8; i++)
+				{
+					const Real wu{ i & 1 ? uvw.x() : 1 - uvw.x() }, su{ i & 1 ? Real{ 1 } : Real{ -1 } };
+					const Real wv{ i & 2 ? uvw.y() : 1 - uvw.y() }, sv{ i & 2 ? Real{ 1 } : Real{ -1 } };
+					const Real ww{ i & 4 ? uvw.z() : 1 - uvw.z() }, sw{ i & 4 ? Real{ 1 } : Real{ -1 } };
+					value += _verts[i] * (wu * wv * ww);
+					du += _verts[i] * (su * wv * ww);
+					dv += _verts[i] * (wu * sv * ww);
+					dw += _verts[i] * (wu * wv * sw);
+				}
+				const RVec3 residual{ value - _point };
+				if (residual.dot(residual) < c_eps * c_eps)
+				{
+					return uvw.x() >= 0 && uvw.x() <= 1 && uvw.y() >= 0 && uvw.y() <= 1 && uvw.z() >= 0 && uvw.z() <= 1;
+				}
+				const Real det{ du.dot(dv.cross(dw)) };
+				if (std::abs(det) < c_eps)
+				{
+					return false;
+				}
+				// Cramer's rule
+				uvw.x() -= residual.dot(dv.cross(dw)) / det;
+				uvw.y() -= du.dot(residual.cross(dw)) / det;
+				uvw.z() -= du.dot(dv.cross(residual)) / det;
+			}
+			return false;
+		}
+
+	}
+
+	SchemeValidator::Report SchemeValidator::operator()(Int _size, const std::vector<HexVertsU>& _children) const
+	{
+		if (_size < 1 || resolution < 1)
+		{
+			throw std::logic_error{ "size and resolution must be positive" };
+		}
+		Report report{};
+		const Int cellsPerDim{ _size * resolution };
+		report.cells = static_cast<std::size_t>(cellsPerDim) * cellsPerDim * cellsPerDim;
+		std::vector<std::atomic<std::uint16_t>> occupancy(report.cells);
+		std::atomic<std::size_t> invalidChildren{ 0 };
+		// jittered sample offsets keep cell centers off the lattice planes
+		const RVec3 jitter{ 0.5 + 1e-3 * std::sqrt(2.0), 0.5 + 1e-3 * std::sqrt(3.0), 0.5 + 1e-3 * std::sqrt(5.0) };
+		// occupancy
+		parallel::forEach(_children.size(), [&](std::size_t _child) {
+			const HexVertsU& child{ _children[_child] };
+			if (!hexUtils::distinctVerts(child))
+			{
+				invalidChildren++;
+				return;
+			}
+			IVec3 min{ child[0] }, max{ child[0] };
+			HexVerts verts;
+			for (std::size_t i{}; i < 8; i++)
+			{
+				for (unsigned int d{}; d < 3; d++)
+				{
+					min[d] = std::max(std::min(min[d], child[i][d]), Int{ 0 });
+					max[d] = std::min(std::max(max[d], child[i][d]), _size);
+				}
+				verts[i] = child[i].cast<Real>() * static_cast<Real>(resolution);
+			}
+			IVec3 cell;
+			for (cell.z() = min.z() * resolution; cell.z() < max.z() * resolution; cell.z()++)
+			{
+				for (cell.y() = min.y() * resolution; cell.y() < max.y() * resolution; cell.y()++)
+				{
+					for (cell.x() = min.x() * resolution; cell.x() < max.x() * resolution; cell.x()++)
+					{
+						if (contains(verts, cell.cast<Real>() + jitter))
+						{
+							const std::size_t index{ static_cast<std::size_t>((cell.z() * cellsPerDim + cell.y()) * cellsPerDim + cell.x()) };
+							occupancy[index]++;
+						}
+					}
+				}
+			}
+		});
+		report.invalidChildren = invalidChildren;
+		for (const std::atomic<std::uint16_t>& count : occupancy)
+		{
+			if (count == 0)
+			{
+				report.gapCells++;
+			}
+			else if (count > 1)
+			{
+				report.overlapCells++;
+			}
+		}
+		// face conformity
+		const FaceIndex index{ _children };
+		for (const auto& [face, refs] : index.faces())
+		{
+			const std::size_t count{ refs.size() };
+			bool onBoundary{ false };
+			for (unsigned int d{}; d < 3; d++)
+			{
+				const Int value{ face[0][d] };
+				if ((value == 0 || value == _size) && face[1][d] == value && face[2][d] == value && face[3][d] == value)
+				{
+					onBoundary = true;
+				}
+			}
+			if (count != (onBoundary ? 1 : 2))
+			{
+				report.nonConformingFaces++;
+			}
+		}
+		return report;
+	}
+
+	std::ostream& operator<<(std::ostream& _stream, const SchemeValidator::Report& _report)
+	{
+		_stream << (_report.valid() ? "Valid" : "Invalid") << " scheme:\n";
+		_stream << "- " << _report.invalidChildren << " children with duplicate vertices\n";
+		_stream << "- " << _report.gapCells << "/" << _report.cells << " uncovered cells\n";
+		_stream << "- " << _report.overlapCells << "/" << _report.cells << " overlapping cells\n";
+		_stream << "- " << _report.nonConformingFaces << " non-conforming faces";
+		return _stream;
+	}
+
+}
\ No newline at end of file
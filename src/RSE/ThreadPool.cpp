@@ -0,0 +1,125 @@
+#include <RSE/ThreadPool.hpp>
+
+#include <RSE/parallel.hpp>
+#include <utility>
+
+namespace RSE
+{
+
+	namespace
+	{
+
+		thread_local const ThreadPool* t_pool{};
+		thread_local std::size_t t_queue{};
+
+	}
+
+	ThreadPool& ThreadPool::shared()
+	{
+		static ThreadPool pool{ parallel::threadCount() - 1 };
+		return pool;
+	}
+
+	ThreadPool::ThreadPool(std::size_t _threadCount) : m_queues{}, m_threads{}, m_mutex{}, m_condition{}, m_pending{ 0 }, m_next{ 0 }, m_stop{ false }
+	{
+		m_queues.reserve(_threadCount + 1);
+		for (std::size_t i{}; i < _threadCount + 1; i++)
+		{
+			m_queues.push_back(std::make_unique<Queue>());
+		}
+		m_threads.reserve(_threadCount);
+		for (std::size_t i{}; i < _threadCount; i++)
+		{
+			m_threads.emplace_back([this, i]() { run(i); });
+		}
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			const std::lock_guard lock{ m_mutex };
+			m_stop = true;
+		}
+		m_condition.notify_all();
+		for (std::thread& thread : m_threads)
+		{
+			thread.join();
+		}
+	}
+
+	std::size_t ThreadPool::size() const
+	{
+		return m_threads.size();
+	}
+
+	std::size_t ThreadPool::queueIndex()
+	{
+		// external threads share the last queue
+		return t_pool == this ? t_queue : m_threads.size();
+	}
+
+	void ThreadPool::submit(Task _task)
+	{
+		const std::size_t queue{ t_pool == this ? t_queue : m_next++ % m_queues.size() };
+		{
+			const std::lock_guard lock{ m_mutex };
+			m_pending++;
+		}
+		{
+			const std::lock_guard lock{ m_queues[queue]->mutex };
+			m_queues[queue]->tasks.push_back(std::move(_task));
+		}
+		m_condition.notify_one();
+	}
+
+	bool ThreadPool::runOne(std::size_t _queue)
+	{
+		Task task{};
+		{
+			Queue& own{ *m_queues[_queue] };
+			const std::lock_guard lock{ own.mutex };
+			if (!own.tasks.empty())
+			{
+				task = std::move(own.tasks.back());
+				own.tasks.pop_back();
+			}
+		}
+		for (std::size_t i{ 1 }; !task && i < m_queues.size(); i++)
+		{
+			Queue& other{ *m_queues[(_queue + i) % m_queues.size()] };
+			const std::lock_guard lock{ other.mutex };
+			if (!other.tasks.empty())
+			{
+				task = std::move(other.tasks.front());
+				other.tasks.pop_front();
+			}
+		}
+		if (!task)
+		{
+			return false;
+		}
+		m_pending--;
+		task();
+		return true;
+	}
+
+	void ThreadPool::run(std::size_t _queue)
+	{
+		t_pool = this;
+		t_queue = _queue;
+		while (true)
+		{
+			if (runOne(_queue))
+			{
+				continue;
+			}
+			std::unique_lock lock{ m_mutex };
+			m_condition.wait(lock, [this]() { return m_stop || m_pending > 0; });
+			if (m_stop)
+			{
+				return;
+			}
+		}
+	}
+
+}
\ No newline at end of file
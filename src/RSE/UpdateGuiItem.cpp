@@ -0,0 +1,14 @@
+#include <RSE/UpdateGuiItem.hpp>
+
+namespace RSE
+{
+
+	UpdateGuiItem::UpdateGuiItem() : onUpdate{}
+	{}
+
+	void UpdateGuiItem::draw()
+	{
+		onUpdate();
+	}
+
+}
\ No newline at end of file
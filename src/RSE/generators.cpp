@@ -0,0 +1,148 @@
+#include <RSE/generators.hpp>
+
+#include <RSE/parallel.hpp>
+#include <stdexcept>
+#include <atomic>
+#include <algorithm>
+
+namespace RSE::generators
+{
+
+	namespace
+	{
+
+		void checkCellSize(Int _cellSize)
+		{
+			if (_cellSize < 1)
+			{
+				throw std::logic_error{ "cell size must be positive" };
+			}
+		}
+
+		// the four quads of the 2D 1-to-3 template on a 3x3 lattice, fine edge at v = 3; corners ordered u + 2v
+		const std::array<QuadVertData<IVec2>, 4> c_transition3Quads{
+			QuadVertData<IVec2>{ IVec2{0,0}, IVec2{3,0}, IVec2{1,2}, IVec2{2,2} },
+			QuadVertData<IVec2>{ IVec2{0,0}, IVec2{1,2}, IVec2{0,3}, IVec2{1,3} },
+			QuadVertData<IVec2>{ IVec2{1,2}, IVec2{2,2}, IVec2{1,3}, IVec2{2,3} },
+			QuadVertData<IVec2>{ IVec2{2,2}, IVec2{3,0}, IVec2{2,3}, IVec2{3,3} }
+		};
+
+	}
+
+	std::vector<HexVertsU> uniform(const IVec3& _min, const IVec3& _max, Int _cellSize)
+	{
+		checkCellSize(_cellSize);
+		IVec3 counts;
+		for (unsigned int d{}; d < 3; d++)
+		{
+			counts[d] = std::max<Int>((_max[d] - _min[d]) / _cellSize, 0);
+		}
+		std::vector<HexVertsU> hexes(static_cast<std::size_t>(counts.x()) * static_cast<std::size_t>(counts.y()) * static_cast<std::size_t>(counts.z()));
+		parallel::forEach(hexes.size(), [&](std::size_t _i) {
+			const Int x{ static_cast<Int>(_i % static_cast<std::size_t>(counts.x())) };
+			const Int y{ static_cast<Int>(_i / static_cast<std::size_t>(counts.x()) % static_cast<std::size_t>(counts.y())) };
+			const Int z{ static_cast<Int>(_i / static_cast<std::size_t>(counts.x() * counts.y())) };
+			const IVec3 min{ _min + IVec3{ x, y, z } * _cellSize };
+			hexes[_i] = hexUtils::cubeVerts(min, IVec3{ min + IVec3{ _cellSize, _cellSize, _cellSize } });
+		});
+		return hexes;
+	}
+
+	std::vector<HexVertsU> graded(const IVec3& _min, const IVec3& _max, Int _cellSize, hexUtils::EDim _dim)
+	{
+		checkCellSize(_cellSize);
+		const unsigned int dim{ static_cast<unsigned int>(_dim) };
+		std::vector<HexVertsU> hexes{};
+		IVec3 min{ _min }, max{ _max };
+		for (Int thickness{ _cellSize }; min[dim] + thickness <= _max[dim]; thickness *= 2)
+		{
+			max[dim] = min[dim] + thickness;
+			const std::vector<HexVertsU> slab{ uniform(min, max, thickness) };
+			hexes.insert(hexes.end(), slab.begin(), slab.end());
+			min[dim] = max[dim];
+		}
+		return hexes;
+	}
+
+	std::vector<HexVertsU> transition3(const IVec3& _min, const IVec3& _max, Int _cellSize, hexUtils::EDim _fineDim, hexUtils::EDim _splitDim)
+	{
+		checkCellSize(_cellSize);
+		if (_fineDim == _splitDim)
+		{
+			throw std::logic_error{ "the fine and split dimensions must differ" };
+		}
+		const unsigned int u{ static_cast<unsigned int>(_splitDim) }, v{ static_cast<unsigned int>(_fineDim) }, w{ 3 - u - v };
+		const Int blockSize{ _cellSize * 3 };
+		if (_max[v] - _min[v] < blockSize)
+		{
+			return {};
+		}
+		const std::size_t blocks{ static_cast<std::size_t>(std::max<Int>((_max[u] - _min[u]) / blockSize, 0)) };
+		const std::size_t layers{ static_cast<std::size_t>(std::max<Int>((_max[w] - _min[w]) / _cellSize, 0)) };
+		std::vector<HexVertsU> hexes(blocks * layers * c_transition3Quads.size());
+		parallel::forEach(blocks * layers, [&](std::size_t _i) {
+			IVec3 origin{ _min };
+			origin[u] += static_cast<Int>(_i % blocks) * blockSize;
+			origin[w] += static_cast<Int>(_i / blocks) * _cellSize;
+			for (std::size_t q{}; q < c_transition3Quads.size(); q++)
+			{
+				HexVertsU& hex{ hexes[_i * c_transition3Quads.size() + q] };
+				for (std::size_t i{}; i < 8; i++)
+				{
+					const IVec2& corner{ c_transition3Quads[q][i % 4] };
+					IVec3& vert{ hex[((i & 1) << u) | (((i >> 1) & 1) << v) | (((i >> 2) & 1) << w)] };
+					vert = origin;
+					vert[u] += corner.x() * _cellSize;
+					vert[v] += corner.y() * _cellSize;
+					vert[w] += static_cast<Int>(i >> 2) * _cellSize;
+				}
+			}
+		});
+		return hexes;
+	}
+
+	std::vector<HexVertsU> transition27(const IVec3& _min, const IVec3& _max, Int _cellSize)
+	{
+		checkCellSize(_cellSize);
+		const Int blockSize{ _cellSize * 3 };
+		IVec3 max;
+		for (unsigned int d{}; d < 3; d++)
+		{
+			max[d] = _min[d] + std::max<Int>((_max[d] - _min[d]) / blockSize, 0) * blockSize;
+		}
+		return uniform(_min, max, _cellSize);
+	}
+
+	std::vector<HexVertsU> generate(const IVec3& _min, const IVec3& _max, const Params& _params)
+	{
+		std::vector<HexVertsU> hexes{};
+		switch (_params.family)
+		{
+			case EFamily::Uniform:
+				hexes = uniform(_min, _max, _params.cellSize);
+				break;
+			case EFamily::Graded:
+				hexes = graded(_min, _max, _params.cellSize, _params.dim);
+				break;
+			case EFamily::Transition3:
+				hexes = transition3(_min, _max, _params.cellSize, _params.dim, _params.splitDim);
+				break;
+			case EFamily::Transition27:
+				hexes = transition27(_min, _max, _params.cellSize);
+				break;
+		}
+		std::atomic<bool> valid{ true };
+		parallel::forEach(hexes.size(), [&](std::size_t _i) {
+			if (!hexUtils::distinctVerts(hexes[_i]))
+			{
+				valid = false;
+			}
+		});
+		if (!valid)
+		{
+			throw std::logic_error{ "generated hexes with coincident vertices" };
+		}
+		return hexes;
+	}
+
+}
\ No newline at end of file
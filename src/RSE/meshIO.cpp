@@ -0,0 +1,211 @@
+#include <RSE/meshIO.hpp>
+
+#include <RSE/schemeIO.hpp>
+#include <RSE/hexUtils.hpp>
+#include <RSE/parallel.hpp>
+#include <charconv>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+namespace RSE::meshIO
+{
+
+	namespace
+	{
+
+		constexpr std::size_t c_blockSize{ 1 << 14 };
+
+		std::size_t elementSize(const std::string& _keyword)
+		{
+			if (_keyword == "Corners" || _keyword == "Ridges" || _keyword == "RequiredVertices")
+			{
+				return 1;
+			}
+			if (_keyword == "Edges")
+			{
+				return 3;
+			}
+			if (_keyword == "Triangles")
+			{
+				return 4;
+			}
+			if (_keyword == "Quadrilaterals" || _keyword == "Tetrahedra")
+			{
+				return 5;
+			}
+			throw std::runtime_error{ "unsupported section '" + _keyword + "'" };
+		}
+
+		void append(std::string& _buffer, std::size_t _value)
+		{
+			char chars[24];
+			_buffer.append(chars, std::to_chars(chars, chars + sizeof(chars), _value).ptr);
+		}
+
+		void append(std::string& _buffer, Real _value)
+		{
+			char chars[32];
+			_buffer.append(chars, std::to_chars(chars, chars + sizeof(chars), _value).ptr);
+		}
+
+		template<typename TFormat>
+		void writeBlocks(std::ostream& _stream, std::size_t _count, const TFormat& _format)
+		{
+			const std::size_t chunks{ parallel::threadCount() * 4 };
+			std::vector<std::string> buffers(chunks);
+			for (std::size_t block{}; block < _count; block += c_blockSize)
+			{
+				const std::size_t blockEnd{ std::min(block + c_blockSize, _count) };
+				const std::size_t chunkSize{ (blockEnd - block + chunks - 1) / chunks };
+				parallel::forEachChunk(blockEnd - block, chunkSize, [&](std::size_t _begin, std::size_t _end) {
+					std::string& buffer{ buffers[_begin / chunkSize] };
+					buffer.clear();
+					for (std::size_t i{ block + _begin }; i < block + _end; i++)
+					{
+						_format(buffer, i);
+					}
+				});
+				for (std::size_t c{}; c * chunkSize < blockEnd - block; c++)
+				{
+					_stream << buffers[c];
+				}
+			}
+		}
+
+	}
+
+	Refiner::Mesh read(std::istream& _stream)
+	{
+		Refiner::Mesh mesh{};
+		std::string keyword{};
+		while (_stream >> keyword)
+		{
+			if (keyword.starts_with("#"))
+			{
+				_stream.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+			}
+			else if (keyword == "MeshVersionFormatted" || keyword == "Dimension")
+			{
+				int value{};
+				_stream >> value;
+				if (keyword == "Dimension" && value != 3)
+				{
+					throw std::runtime_error{ "unsupported dimension" };
+				}
+			}
+			else if (keyword == "End")
+			{
+				break;
+			}
+			else
+			{
+				std::size_t count{};
+				_stream >> count;
+				if (keyword == "Vertices")
+				{
+					mesh.verts.resize(count);
+					for (RVec3& vert : mesh.verts)
+					{
+						int ref{};
+						_stream >> vert.x() >> vert.y() >> vert.z() >> ref;
+					}
+				}
+				else if (keyword == "Hexahedra")
+				{
+					mesh.hexes.resize(count);
+					for (HexVertData<std::size_t>& hex : mesh.hexes)
+					{
+						HexVertData<std::size_t> verts;
+						int ref{};
+						for (std::size_t& vert : verts)
+						{
+							_stream >> vert;
+						}
+						_stream >> ref;
+						for (std::size_t i{}; i < 8; i++)
+						{
+							hex[i] = verts[hexUtils::cinolibHexInds[i]] - 1;
+						}
+					}
+				}
+				else
+				{
+					const std::size_t size{ elementSize(keyword) };
+					for (std::size_t i{}; i < count * size; i++)
+					{
+						Real value;
+						_stream >> value;
+					}
+				}
+			}
+			if (!_stream)
+			{
+				throw std::runtime_error{ "malformed mesh" };
+			}
+		}
+		for (const HexVertData<std::size_t>& hex : mesh.hexes)
+		{
+			for (const std::size_t vert : hex)
+			{
+				if (vert >= mesh.verts.size())
+				{
+					throw std::runtime_error{ "vertex index out of range" };
+				}
+			}
+		}
+		return mesh;
+	}
+
+	Refiner::Mesh load(const std::string& _filename)
+	{
+		std::ifstream file{};
+		file.open(_filename);
+		if (!file)
+		{
+			throw std::runtime_error{ "cannot open '" + _filename + "'" };
+		}
+		Refiner::Mesh mesh{ read(file) };
+		file.close();
+		return mesh;
+	}
+
+	void write(std::ostream& _stream, const Refiner::Refinement& _refinement)
+	{
+		const std::vector<RVec3>& verts{ _refinement.verts() };
+		_stream << "MeshVersionFormatted 1\n\nDimension 3\n\nVertices\n" << verts.size() << '\n';
+		writeBlocks(_stream, verts.size(), [&](std::string& _buffer, std::size_t _vert) {
+			for (unsigned int d{}; d < 3; d++)
+			{
+				append(_buffer, verts[_vert][d]);
+				_buffer += ' ';
+			}
+			_buffer += "0\n";
+		});
+		_stream << "\nHexahedra\n" << _refinement.hexCount() << '\n';
+		const std::vector<HexVertData<std::size_t>>& children{ _refinement.children() };
+		writeBlocks(_stream, _refinement.sourceHexCount(), [&](std::string& _buffer, std::size_t _hex) {
+			thread_local std::vector<std::size_t> pointVerts{};
+			pointVerts.resize(_refinement.pointCount());
+			_refinement.pointVerts(_hex, pointVerts.data());
+			for (const HexVertData<std::size_t>& child : children)
+			{
+				for (std::size_t i{}; i < 8; i++)
+				{
+					append(_buffer, pointVerts[child[hexUtils::cinolibHexInds[i]]] + 1);
+					_buffer += ' ';
+				}
+				_buffer += "0\n";
+			}
+		});
+		_stream << "\nEnd\n";
+	}
+
+	void save(const std::string& _filename, const Refiner::Refinement& _refinement)
+	{
+		schemeIO::writeAtomic(_filename, [&](std::ostream& _stream) { write(_stream, _refinement); });
+	}
+
+}
\ No newline at end of file
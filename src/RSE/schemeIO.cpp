@@ -0,0 +1,113 @@
+#include <RSE/schemeIO.hpp>
+
+#include <cpputils/serialization/Serializer.hpp>
+#include <cpputils/serialization/Deserializer.hpp>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+#include <string>
+
+namespace RSE::schemeIO
+{
+
+	void write(std::ostream& _stream, Int _size, const std::vector<HexVertsU>& _children)
+	{
+		cpputils::serialization::Serializer s{ _stream };
+		s << _size << _children.size();
+		for (const HexVertsU& child : _children)
+		{
+			for (const IVec3& vert : child)
+			{
+				s << vert.x() << vert.y() << vert.z();
+			}
+		}
+	}
+
+	Scheme read(std::istream& _stream)
+	{
+		// a corrupted count must not allocate more than the input actually holds
+		constexpr std::size_t c_maxReserve{ 1 << 16 };
+		cpputils::serialization::Deserializer s{ _stream };
+		Scheme scheme{};
+		std::size_t childrenSize{};
+		s >> scheme.size >> childrenSize;
+		if (!_stream)
+		{
+			throw std::runtime_error{ "cannot read the scheme header" };
+		}
+		scheme.children.reserve(std::min(childrenSize, c_maxReserve));
+		for (std::size_t c{}; c < childrenSize; c++)
+		{
+			HexVertsU child;
+			for (IVec3& vert : child)
+			{
+				s >> vert.x() >> vert.y() >> vert.z();
+			}
+			if (!_stream)
+			{
+				throw std::runtime_error{ "truncated scheme: read " + std::to_string(c) + " of " + std::to_string(childrenSize) + " children" };
+			}
+			scheme.children.push_back(child);
+		}
+		return scheme;
+	}
+
+	void validate(Int _size, const std::vector<HexVertsU>& _children)
+	{
+		if (_size < 1)
+		{
+			throw std::logic_error{ "size must be positive" };
+		}
+		for (std::size_t c{}; c < _children.size(); c++)
+		{
+			for (const IVec3& vert : _children[c])
+			{
+				for (unsigned int d{}; d < 3; d++)
+				{
+					if (vert[d] < 0 || vert[d] > _size)
+					{
+						throw std::logic_error{ "child " + std::to_string(c) + " has a vertex outside [0, " + std::to_string(_size) + "]" };
+					}
+				}
+			}
+		}
+	}
+
+	void save(const std::string& _filename, Int _size, const std::vector<HexVertsU>& _children)
+	{
+		writeAtomic(_filename, [&](std::ostream& _stream) {
+			write(_stream, _size, _children);
+		});
+	}
+
+	Scheme load(const std::string& _filename)
+	{
+		std::ifstream file{};
+		file.open(_filename);
+		if (!file)
+		{
+			throw std::runtime_error{ "cannot open '" + _filename + "'" };
+		}
+		Scheme scheme{ read(file) };
+		file.close();
+		return scheme;
+	}
+
+	void writeAtomic(const std::string& _filename, const std::function<void(std::ostream&)>& _write, bool _binary)
+	{
+		const std::string tempFilename{ _filename + ".tmp" };
+		{
+			std::ofstream file{};
+			file.open(tempFilename, _binary ? std::ios::out | std::ios::binary : std::ios::out);
+			_write(file);
+			file.close();
+			if (!file)
+			{
+				throw std::runtime_error{ "cannot write '" + tempFilename + "'" };
+			}
+		}
+		std::filesystem::rename(tempFilename, _filename);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include <RSE/symmetry.hpp>
+
+#include <unordered_set>
+
+namespace RSE::symmetry
+{
+
+	std::string name(const Symmetry& _symmetry)
+	{
+		static constexpr char c_axisNames[3]{ 'x', 'y', 'z' };
+		std::string name{ "(" };
+		for (unsigned int d{}; d < 3; d++)
+		{
+			if (d)
+			{
+				name += ", ";
+			}
+			if (_symmetry.mirrored[d])
+			{
+				name += '-';
+			}
+			name += c_axisNames[_symmetry.axes[d]];
+		}
+		return name + ")";
+	}
+
+	HexVertsU canonical(const HexVertsU& _hex)
+	{
+		const auto less{ [](const HexVertsU& _a, const HexVertsU& _b) {
+			for (std::size_t i{}; i < 8; i++)
+			{
+				for (unsigned int d{}; d < 3; d++)
+				{
+					if (_a[i][d] != _b[i][d])
+					{
+						return _a[i][d] < _b[i][d];
+					}
+				}
+			}
+			return false;
+		} };
+		HexVertsU min{ _hex };
+		for (const Symmetry& symmetry : symmetries)
+		{
+			HexVertsU relabeled;
+			for (std::size_t i{}; i < 8; i++)
+			{
+				relabeled[i] = _hex[symmetry.inds[i]];
+			}
+			if (less(relabeled, min))
+			{
+				min = relabeled;
+			}
+		}
+		return min;
+	}
+
+	std::vector<std::size_t> duplicates(const std::vector<HexVertsU>& _hexes)
+	{
+		std::unordered_set<HexVertsU, HexHasher> seen{};
+		seen.reserve(_hexes.size());
+		std::vector<std::size_t> duplicates{};
+		for (std::size_t i{}; i < _hexes.size(); i++)
+		{
+			if (!seen.insert(canonical(_hexes[i])).second)
+			{
+				duplicates.push_back(i);
+			}
+		}
+		return duplicates;
+	}
+
+}
\ No newline at end of file
@@ -1,9 +1,118 @@
 #include <RSE/App.hpp>
+#include <RSE/schemeIO.hpp>
+#include <RSE/SchemeValidator.hpp>
+#include <RSE/InputLog.hpp>
+#include <RSE/Commands.hpp>
+#include <RSE/CppExporter.hpp>
 
 #include <iostream>
+#include <string_view>
+#include <string>
+#include <optional>
+#include <vector>
+#include <chrono>
+#include <exception>
 
 int main(int _argc, char** _argv)
 {
+    if (_argc == 3 && std::string_view{ _argv[1] } == "--validate")
+    {
+        try
+        {
+            const RSE::schemeIO::Scheme scheme{ RSE::schemeIO::load(_argv[2]) };
+            const RSE::SchemeValidator::Report report{ RSE::SchemeValidator{}(scheme.size, scheme.children) };
+            std::cout << report << std::endl;
+            return report.valid() ? 0 : 2;
+        }
+        catch (const std::exception& _exception)
+        {
+            std::cerr << _exception.what() << std::endl;
+            return 2;
+        }
+    }
+    if ((_argc == 4 || _argc == 5) && std::string_view{ _argv[1] } == "--render")
+    {
+        try
+        {
+            const std::size_t frames{ static_cast<std::size_t>(std::stoul(_argv[3])) };
+            RSE::App app{};
+            const std::optional<std::string> imagePrefix{ _argc == 5 ? std::optional<std::string>{ _argv[4] } : std::nullopt };
+            std::cout << app.render(_argv[2], frames, imagePrefix) << std::endl;
+        }
+        catch (const std::exception& _exception)
+        {
+            std::cerr << _exception.what() << std::endl;
+            return 2;
+        }
+        return 0;
+    }
+    if (_argc >= 4 && std::string_view{ _argv[1] } == "--export")
+    {
+        const std::vector<std::string> files(_argv + 3, _argv + _argc);
+        try
+        {
+            const bool written{ RSE::CppExporter{}.exportFiles(files, _argv[2]) };
+            std::cout << (written ? "Exported " : "Up to date: ") << files.size() << " schemes to '" << _argv[2] << "'" << std::endl;
+        }
+        catch (const std::exception& _exception)
+        {
+            std::cerr << _exception.what() << std::endl;
+            return 2;
+        }
+        return 0;
+    }
+    if (_argc == 3 && std::string_view{ _argv[1] } == "--script")
+    {
+        RSE::AppSidebarItem model{};
+        RSE::Commands commands{ model };
+        const auto start{ std::chrono::steady_clock::now() };
+        try
+        {
+            const std::size_t count{ commands.runFile(_argv[2], std::cout) };
+            std::cout << "Ran " << count << " lines in " << std::chrono::duration<double>{ std::chrono::steady_clock::now() - start }.count() << "s (" << model.children().size() << " children)" << std::endl;
+        }
+        catch (const std::exception& _exception)
+        {
+            std::cerr << _exception.what() << std::endl;
+            return 2;
+        }
+        return 0;
+    }
+    if ((_argc == 3 || _argc == 4) && std::string_view{ _argv[1] } == "--record")
+    {
+        RSE::App app{};
+        RSE::InputLog log{};
+        if (_argc == 4)
+        {
+            log.file = _argv[3];
+        }
+        try
+        {
+            const int result{ app.record(log) };
+            log.save(_argv[2]);
+            return result;
+        }
+        catch (const std::exception& _exception)
+        {
+            std::cerr << _exception.what() << std::endl;
+            return 2;
+        }
+    }
+    if ((_argc == 3 || (_argc == 4 && std::string_view{ _argv[3] } == "--render")) && std::string_view{ _argv[1] } == "--replay")
+    {
+        try
+        {
+            const RSE::InputLog log{ RSE::InputLog::load(_argv[2]) };
+            RSE::App app{};
+            std::cout << app.replay(log, _argc == 4) << std::endl;
+        }
+        catch (const std::exception& _exception)
+        {
+            std::cerr << _exception.what() << std::endl;
+            return 2;
+        }
+        return 0;
+    }
     RSE::App app{};
     if (_argc == 2)
     {
@@ -11,8 +120,8 @@ int main(int _argc, char** _argv)
     }
     else if (_argc > 2)
     {
-        std::cerr << "0 or 1 arguments expected" << std::endl;
+        std::cerr << "0 or 1 arguments expected (or --validate <file>, or --render <file> <frames> [<image prefix>], or --record <log> [<file>], or --replay <log> [--render], or --script <script>, or --export <header> <file>...)" << std::endl;
         return 1;
     }
     return app.launch();
-}
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#include <RSE/Refiner.hpp>
+#include <RSE/schemeIO.hpp>
+#include <RSE/meshIO.hpp>
+
+#include <chrono>
+#include <exception>
+#include <iostream>
+
+namespace
+{
+
+    double secondsSince(std::chrono::steady_clock::time_point _start)
+    {
+        return std::chrono::duration<double>{ std::chrono::steady_clock::now() - _start }.count();
+    }
+
+}
+
+int main(int _argc, char** _argv)
+{
+    if (_argc != 4)
+    {
+        std::cerr << "usage: rse-refine <scheme.rse> <input.mesh> <output.mesh>" << std::endl;
+        return 1;
+    }
+    try
+    {
+        const RSE::schemeIO::Scheme scheme{ RSE::schemeIO::load(_argv[1]) };
+        auto start{ std::chrono::steady_clock::now() };
+        const RSE::Refiner::Mesh source{ RSE::meshIO::load(_argv[2]) };
+        std::cout << "read " << source.verts.size() << " verts and " << source.hexes.size() << " hexes in " << secondsSince(start) << "s" << std::endl;
+        start = std::chrono::steady_clock::now();
+        const RSE::Refiner::Refinement refinement{ RSE::Refiner{}(scheme.size, scheme.children, source) };
+        const double refineTime{ secondsSince(start) };
+        std::cout << "refined into " << refinement.verts().size() << " verts and " << refinement.hexCount() << " hexes in " << refineTime << "s";
+        if (refineTime > 0)
+        {
+            std::cout << " (" << static_cast<double>(source.hexes.size()) / refineTime << " hexes/s)";
+        }
+        std::cout << std::endl;
+        start = std::chrono::steady_clock::now();
+        RSE::meshIO::save(_argv[3], refinement);
+        std::cout << "written in " << secondsSince(start) << "s" << std::endl;
+    }
+    catch (const std::exception& _exception)
+    {
+        std::cerr << _exception.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file